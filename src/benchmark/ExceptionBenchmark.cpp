@@ -0,0 +1,108 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin */
+#include "CardIOException.h"
+#include "ReaderIOException.h"
+
+using namespace keyple::core::plugin;
+
+static void BM_CardIOException_construct(benchmark::State& state)
+{
+    for (auto _ : state) {
+        CardIOException e("Card communication failure");
+        benchmark::DoNotOptimize(e);
+    }
+}
+BENCHMARK(BM_CardIOException_construct);
+
+static void BM_CardIOException_throwCatch(benchmark::State& state)
+{
+    for (auto _ : state) {
+        try {
+            throw CardIOException("Card communication failure");
+        } catch (const CardIOException& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_CardIOException_throwCatch);
+
+static void BM_ReaderIOException_construct(benchmark::State& state)
+{
+    for (auto _ : state) {
+        ReaderIOException e("Reader communication failure");
+        benchmark::DoNotOptimize(e);
+    }
+}
+BENCHMARK(BM_ReaderIOException_construct);
+
+static void BM_ReaderIOException_constructWithCause(benchmark::State& state)
+{
+    for (auto _ : state) {
+        ReaderIOException e("Reader communication failure",
+                            std::make_shared<CardIOException>("Card communication failure"));
+        benchmark::DoNotOptimize(e);
+    }
+}
+BENCHMARK(BM_ReaderIOException_constructWithCause);
+
+static void BM_ReaderIOException_throwCatch(benchmark::State& state)
+{
+    for (auto _ : state) {
+        try {
+            throw ReaderIOException("Reader communication failure");
+        } catch (const ReaderIOException& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_ReaderIOException_throwCatch);
+
+static void BM_CardIOException_constructStatic(benchmark::State& state)
+{
+    for (auto _ : state) {
+        CardIOException e(0, "Card communication failure");
+        benchmark::DoNotOptimize(e);
+    }
+}
+BENCHMARK(BM_CardIOException_constructStatic);
+
+static void BM_CardIOException_throwCatchStatic(benchmark::State& state)
+{
+    for (auto _ : state) {
+        try {
+            throw CardIOException(0, "Card communication failure");
+        } catch (const CardIOException& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_CardIOException_throwCatchStatic);
+
+static void BM_ReaderIOException_constructStaticWithCause(benchmark::State& state)
+{
+    for (auto _ : state) {
+        try {
+            throw CardIOException(0, "Card communication failure");
+        } catch (const CardIOException&) {
+            ReaderIOException e(0, "Reader communication failure", std::current_exception());
+            benchmark::DoNotOptimize(e);
+        }
+    }
+}
+BENCHMARK(BM_ReaderIOException_constructStaticWithCause);
@@ -0,0 +1,63 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin */
+#include "VirtualObservablePluginSpi.h"
+
+using namespace keyple::core::plugin::cpp;
+
+static void BM_searchAvailableReaders(benchmark::State& state)
+{
+    VirtualObservablePluginSpi plugin("VIRTUAL", static_cast<std::size_t>(state.range(0)), true);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plugin.searchAvailableReaders());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_searchAvailableReaders)->RangeMultiplier(8)->Range(8, 32768);
+
+static void BM_searchAvailableReaderNames(benchmark::State& state)
+{
+    VirtualObservablePluginSpi plugin("VIRTUAL", static_cast<std::size_t>(state.range(0)), true);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plugin.searchAvailableReaderNames());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_searchAvailableReaderNames)->RangeMultiplier(8)->Range(8, 32768);
+
+/* Monitoring cycle of an unchanged readers list, based on the epoch instead of the names */
+static void BM_getReaderNamesEpoch(benchmark::State& state)
+{
+    VirtualObservablePluginSpi plugin("VIRTUAL", static_cast<std::size_t>(state.range(0)), true);
+    const uint64_t epoch = plugin.getReaderNamesEpoch();
+
+    for (auto _ : state) {
+        std::vector<std::string> connected;
+        std::vector<std::string> disconnected;
+        if (plugin.getReaderNamesEpoch() != epoch) {
+            plugin.searchReaderNamesChanges(epoch, connected, disconnected);
+        }
+        benchmark::DoNotOptimize(connected);
+    }
+}
+BENCHMARK(BM_getReaderNamesEpoch)->RangeMultiplier(8)->Range(8, 32768);
@@ -0,0 +1,98 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin */
+#include "ConcurrentPoolPluginSpi.h"
+#include "VirtualPoolPluginSpi.h"
+
+using namespace keyple::core::plugin::cpp;
+
+static const std::string GROUP = "GROUP";
+
+/* Shared by the threads of a run (set up before the start barrier), with a reader per thread */
+static std::unique_ptr<VirtualPoolPluginSpi> sharedPool;
+
+static void BM_allocateReleaseReader(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        sharedPool.reset(new VirtualPoolPluginSpi("POOL", {{GROUP, 64}}, true));
+    }
+
+    for (auto _ : state) {
+        std::shared_ptr<ReaderSpi> reader = sharedPool->allocateReader(GROUP);
+        sharedPool->releaseReader(reader);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_allocateReleaseReader)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_allocateReleaseReaders(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        sharedPool.reset(new VirtualPoolPluginSpi("POOL", {{GROUP, 64}}, true));
+    }
+
+    for (auto _ : state) {
+        sharedPool->releaseReaders(sharedPool->allocateReaders(
+            GROUP, 2, PoolPluginSpi::BulkAllocationMode::ALL_OR_NOTHING));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_allocateReleaseReaders)->ThreadRange(1, 32)->UseRealTime();
+
+class ConcurrentPool final : public ConcurrentPoolPluginSpi {
+public:
+    explicit ConcurrentPool(const VirtualPoolPluginSpi& readers)
+    : ConcurrentPoolPluginSpi({{GROUP, toReaderSpis(readers.getReaders(GROUP))}}) {}
+
+    const std::string& getName() const override
+    {
+        static const std::string NAME = "CONCURRENT_POOL";
+
+        return NAME;
+    }
+
+    void onUnregister() override {}
+
+private:
+    static std::vector<std::shared_ptr<ReaderSpi>> toReaderSpis(
+        const std::vector<std::shared_ptr<VirtualReaderSpi>>& readers)
+    {
+        return std::vector<std::shared_ptr<ReaderSpi>>(readers.begin(), readers.end());
+    }
+};
+
+static std::unique_ptr<ConcurrentPool> sharedConcurrentPool;
+
+static void BM_allocateReleaseReader_concurrentPool(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        sharedConcurrentPool.reset(
+            new ConcurrentPool(VirtualPoolPluginSpi("POOL", {{GROUP, 64}}, true)));
+    }
+
+    for (auto _ : state) {
+        std::shared_ptr<ReaderSpi> reader = sharedConcurrentPool->allocateReader(GROUP);
+        sharedConcurrentPool->releaseReader(reader);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_allocateReleaseReader_concurrentPool)->ThreadRange(1, 32)->UseRealTime();
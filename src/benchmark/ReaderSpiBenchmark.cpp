@@ -0,0 +1,157 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin */
+#include "ApduResponseChainer.h"
+#include "CardIOException.h"
+#include "InstrumentedReaderSpi.h"
+#include "TracingReaderSpi.h"
+#include "VirtualReaderSpi.h"
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+
+static const std::vector<uint8_t> APDU = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> RESP = {0x12, 0x34, 0x90, 0x00};
+
+static std::shared_ptr<VirtualReaderSpi> createReader()
+{
+    auto reader = std::make_shared<VirtualReaderSpi>("READER", true);
+    reader->insertCard({0x3B, 0x00}, [](const std::vector<uint8_t>&) { return RESP; });
+    reader->openPhysicalChannel();
+
+    return reader;
+}
+
+static void runTransmitApdu(benchmark::State& state, ReaderSpi& reader)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.transmitApdu(APDU));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_transmitApdu_virtualReader(benchmark::State& state)
+{
+    runTransmitApdu(state, *createReader());
+}
+BENCHMARK(BM_transmitApdu_virtualReader);
+
+static void BM_transmitApdu_instrumentedReader(benchmark::State& state)
+{
+    InstrumentedReaderSpi reader(createReader());
+    runTransmitApdu(state, reader);
+}
+BENCHMARK(BM_transmitApdu_instrumentedReader);
+
+static void BM_transmitApdu_tracingInstrumentedReader(benchmark::State& state)
+{
+    TracingReaderSpi reader(std::make_shared<InstrumentedReaderSpi>(createReader()),
+                            std::make_shared<ApduTraceBuffer>("READER"));
+    runTransmitApdu(state, reader);
+}
+BENCHMARK(BM_transmitApdu_tracingInstrumentedReader);
+
+static void BM_transmitApduInto_virtualReader(benchmark::State& state)
+{
+    std::shared_ptr<VirtualReaderSpi> reader = createReader();
+    uint8_t apduOut[258];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader->transmitApduInto(APDU.data(), APDU.size(), apduOut, sizeof(apduOut)));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_transmitApduInto_virtualReader);
+
+static void BM_transmitApduInto_whenCardIsRemoved(benchmark::State& state)
+{
+    std::shared_ptr<VirtualReaderSpi> reader = createReader();
+    reader->removeCard();
+    uint8_t apduOut[258];
+
+    for (auto _ : state) {
+        try {
+            reader->transmitApduInto(APDU.data(), APDU.size(), apduOut, sizeof(apduOut));
+        } catch (const CardIOException& e) {
+            benchmark::DoNotOptimize(&e);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_transmitApduInto_whenCardIsRemoved);
+
+static void BM_tryTransmitApdu_whenCardIsRemoved(benchmark::State& state)
+{
+    std::shared_ptr<VirtualReaderSpi> reader = createReader();
+    reader->removeCard();
+    uint8_t apduOut[258];
+    std::size_t apduOutLength;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader->tryTransmitApdu(
+            APDU.data(), APDU.size(), apduOut, sizeof(apduOut), apduOutLength));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_tryTransmitApdu_whenCardIsRemoved);
+
+static void BM_transmitApdus_virtualReader(benchmark::State& state)
+{
+    std::shared_ptr<VirtualReaderSpi> reader = createReader();
+    const std::vector<BatchedApdu> apdus(static_cast<std::size_t>(state.range(0)),
+                                         BatchedApdu(APDU));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader->transmitApdus(apdus));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_transmitApdus_virtualReader)->Arg(1)->Arg(8)->Arg(64);
+
+static void BM_transmit_responseChainer(benchmark::State& state)
+{
+    /* The card answers 61xy, then the response to the GET RESPONSE */
+    ApduResponseChainer chainer(
+        [](const uint8_t* apduIn, std::size_t, uint8_t* apduOut, std::size_t) -> std::size_t {
+            if (apduIn[1] == 0xC0) {
+                apduOut[0] = 0x12;
+                apduOut[1] = 0x34;
+                apduOut[2] = 0x90;
+                apduOut[3] = 0x00;
+                return 4;
+            }
+            apduOut[0] = 0x61;
+            apduOut[1] = 0x02;
+            return 2;
+        });
+    uint8_t apduOut[258];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            chainer.transmit(APDU.data(), APDU.size(), apduOut, sizeof(apduOut)));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_transmit_responseChainer);
@@ -12,7 +12,12 @@
 
 #pragma once
 
-#include "Exception.h"
+#include <exception>
+#include <memory>
+#include <string>
+
+/* Plugin */
+#include "CodedException.h"
 
 namespace keyple {
 namespace core {
@@ -25,13 +30,13 @@ using namespace keyple::core::util::cpp::exception;
  *
  * @since 2.0.0
  */
-class CardIOException : public Exception {
+class CardIOException : public CodedException {
 public:
     /**
      * @param message the message to identify the exception context
      * @since 2.0.0
      */
-    CardIOException(const std::string& message) : Exception(message) {}
+    CardIOException(const std::string& message) : CodedException(Category::CARD_IO, message) {}
 
     /**
      * @param message the message to identify the exception context
@@ -39,7 +44,20 @@ public:
      * @since 2.0.0
      */
     CardIOException(const std::string& message, const std::shared_ptr<Exception> cause)
-    : Exception(message, cause) {}
+    : CodedException(Category::CARD_IO, message, cause) {}
+
+    /**
+     * Creates the exception without allocating.
+     *
+     * @param code The plugin-specific error code.
+     * @param staticMessage A string literal.
+     * @param cause The exception being handled (std::current_exception()), if any.
+     * @since 2.1.0
+     */
+    CardIOException(const int code,
+                    const StaticMessage& staticMessage,
+                    const std::exception_ptr& cause = nullptr) noexcept
+    : CodedException(Category::CARD_IO, code, staticMessage, cause) {}
 };
 
 }
@@ -0,0 +1,178 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include "Exception.h"
+
+/* Plugin */
+#include "StaticMessage.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Base of the plugin exceptions, carrying an error category and a numeric code.
+ *
+ * <p>Besides the historical constructors, which copy the message into a std::string and take the
+ * cause as a std::shared_ptr, each exception can be built from a string literal (see
+ * StaticMessage) and the std::exception_ptr of the exception being handled, if any. Such
+ * exceptions do not allocate: the message is only referenced, and the cause is only converted or
+ * rethrown if the catcher asks for it. Their message is returned by what() as is, and copied into
+ * a std::string on the first invocation of getMessage().
+ *
+ * @since 2.1.0
+ */
+class CodedException : public Exception {
+public:
+    /**
+     * Category of the error, identifying the type of the exception.
+     *
+     * @since 2.1.0
+     */
+    enum class Category : uint8_t {
+        CARD_IO = 1,
+        READER_IO = 2,
+        PLUGIN_IO = 3,
+        TASK_CANCELED = 4
+    };
+
+    /**
+     * @return The category of the error.
+     * @since 2.1.0
+     */
+    Category getCategory() const noexcept
+    {
+        return mCategory;
+    }
+
+    /**
+     * @return The plugin-specific error code, 0 if not provided.
+     * @since 2.1.0
+     */
+    int getCode() const noexcept
+    {
+        return mCode;
+    }
+
+    /**
+     * Gets the cause provided as a std::exception_ptr, which can be rethrown to be inspected.
+     *
+     * <p>The cause provided as a std::shared_ptr is returned by getCause().
+     *
+     * @return A null pointer if no such cause has been provided.
+     * @since 2.1.0
+     */
+    const std::exception_ptr& getCauseException() const noexcept
+    {
+        return mCauseException;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const char* what() const noexcept override
+    {
+        return mStaticMessage != nullptr ? mStaticMessage : Exception::what();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getMessage() const override
+    {
+        if (mStaticMessage == nullptr) {
+            return Exception::getMessage();
+        }
+
+        /* Built once, even if several threads inspect the same exception */
+        std::shared_ptr<const std::string> message = std::atomic_load(&mMessage);
+        if (!message) {
+            std::shared_ptr<const std::string> current;
+            message = std::make_shared<const std::string>(mStaticMessage);
+            if (!std::atomic_compare_exchange_strong(&mMessage, &current, message)) {
+                message = current;
+            }
+        }
+
+        return *message;
+    }
+
+protected:
+    /**
+     *
+     */
+    CodedException(const Category category, const std::string& message)
+    : Exception(message), mCategory(category), mCode(0), mStaticMessage(nullptr) {}
+
+    /**
+     *
+     */
+    CodedException(const Category category,
+                   const std::string& message,
+                   const std::shared_ptr<Exception> cause)
+    : Exception(message, cause), mCategory(category), mCode(0), mStaticMessage(nullptr) {}
+
+    /**
+     * An empty std::string does not allocate.
+     */
+    CodedException(const Category category,
+                   const int code,
+                   const StaticMessage& staticMessage,
+                   const std::exception_ptr& cause)
+    : Exception(std::string()),
+      mCategory(category),
+      mCode(code),
+      mStaticMessage(staticMessage.get()),
+      mCauseException(cause) {}
+
+private:
+    /**
+     *
+     */
+    Category mCategory;
+
+    /**
+     *
+     */
+    int mCode;
+
+    /**
+     *
+     */
+    const char* mStaticMessage;
+
+    /**
+     *
+     */
+    std::exception_ptr mCauseException;
+
+    /**
+     * Copy of the static message, built by getMessage().
+     */
+    mutable std::shared_ptr<const std::string> mMessage;
+};
+
+}
+}
+}
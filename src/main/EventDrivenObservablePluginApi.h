@@ -0,0 +1,65 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+
+/**
+ * API associated to a keyple::core::plugin::spi::EventDrivenObservablePluginSpi.
+ *
+ * <p>Allows the plugin to notify Keyple Core of changes in its list of readers instead of being
+ * polled periodically.
+ *
+ * @since 2.1.0
+ */
+class EventDrivenObservablePluginApi {
+public:
+    /**
+     *
+     */
+    virtual ~EventDrivenObservablePluginApi() = default;
+
+    /**
+     * Must be invoked when the list of available readers may have changed, without details.
+     *
+     * <p>Keyple Core then invokes ObservablePluginSpi::searchAvailableReaderNames once to determine
+     * the connected and disconnected readers.
+     *
+     * @since 2.1.0
+     */
+    virtual void onReaderListChanged() = 0;
+
+    /**
+     * Must be invoked when the plugin knows exactly which readers have been connected or
+     * disconnected.
+     *
+     * <p>Keyple Core invokes ObservablePluginSpi::searchReader for each connected reader and does
+     * not need to enumerate the whole list of readers.
+     *
+     * @param connectedReaderNames The names of the readers connected (may be empty).
+     * @param disconnectedReaderNames The names of the readers disconnected (may be empty).
+     * @throw IllegalArgumentException If both lists are empty.
+     * @since 2.1.0
+     */
+    virtual void onReaderListChanged(const std::vector<std::string>& connectedReaderNames,
+                                     const std::vector<std::string>& disconnectedReaderNames) = 0;
+};
+
+}
+}
+}
@@ -40,7 +40,7 @@ namespace plugin {
 // };
 
 // const std::string PluginApiProperties::VERSION = "2.0";
-static const std::string PluginApiProperties_VERSION = "2.0";
+static const std::string PluginApiProperties_VERSION = "2.1";
 
 }
 }
@@ -0,0 +1,57 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+
+/**
+ * Reference to a message with static storage duration, used by the exceptions and statuses
+ * created without allocating (see CodedException).
+ *
+ * <p>It can only be built from a character array, typically a string literal, so that a pointer
+ * to a transient string (for example std::string::c_str()) is rejected at compile time. Arrays
+ * other than literals must therefore outlive the objects referencing them.
+ *
+ * @since 2.1.0
+ */
+class StaticMessage final {
+public:
+    /**
+     * @param message A string literal.
+     * @since 2.1.0
+     */
+    template <std::size_t N>
+    StaticMessage(const char (&message)[N]) noexcept : mMessage(message) {}
+
+    /**
+     * @return A not null string.
+     * @since 2.1.0
+     */
+    const char* get() const noexcept
+    {
+        return mMessage;
+    }
+
+private:
+    /**
+     *
+     */
+    const char* mMessage;
+};
+
+}
+}
+}
@@ -12,7 +12,12 @@
 
 #pragma once
 
-#include "Exception.h"
+#include <exception>
+#include <memory>
+#include <string>
+
+/* Plugin */
+#include "CodedException.h"
 
 namespace keyple {
 namespace core {
@@ -26,13 +31,24 @@ using namespace keyple::core::util::cpp::exception;
  *
  * @since 2.0.0
  */
-class TaskCanceledException : public Exception {
+class TaskCanceledException : public CodedException {
 public:
     /**
      * @param message the message to identify the exception context
      * @since 2.0.0
      */
-    TaskCanceledException(const std::string& message) : Exception(message) {}
+    TaskCanceledException(const std::string& message)
+    : CodedException(Category::TASK_CANCELED, message) {}
+
+    /**
+     * Creates the exception without allocating.
+     *
+     * @param code The plugin-specific error code.
+     * @param staticMessage A string literal.
+     * @since 2.1.0
+     */
+    TaskCanceledException(const int code, const StaticMessage& staticMessage) noexcept
+    : CodedException(Category::TASK_CANCELED, code, staticMessage, nullptr) {}
 };
 
 }
@@ -0,0 +1,369 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+/* Plugin */
+#include "LatencyHistogram.h"
+#include "TaskCanceledException.h"
+#include "WaitStatus.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi::reader::observable;
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Card insertion and removal detection engine polling the card presence at an adaptive rate, from
+ * which a reader implements the blocking waits of spi::reader::observable::state::insertion::
+ * WaitForCardInsertionBlockingSpi and spi::reader::observable::state::removal::
+ * WaitForCardRemovalBlockingSpi on top of its presence check.
+ *
+ * <p>The polling interval starts at the minimum interval (the latency budget) and doubles after
+ * each unsuccessful poll up to the maximum interval (the CPU budget when idle). It falls back to
+ * the minimum interval, for the configured activity duration, after each card removal and each
+ * {@link #signalActivity()} (for example when the reader reports a near-field event), when a
+ * card is the most likely to be presented.
+ *
+ * <p>The detection latency of each insertion, measured as the time elapsed since the last poll
+ * without card (an upper bound of the actual latency), is recorded in
+ * {@link #getDetectionLatencies()}.
+ *
+ * <p>A stopped wait returns as soon as the ongoing presence check, if any, has completed, which
+ * keeps the stop latency within MAX_STOP_LATENCY_MILLIS as long as the presence check does.
+ *
+ * <p>All methods are thread-safe; one wait at a time is supported.
+ *
+ * @since 2.1.0
+ */
+class AdaptiveCardDetector final {
+public:
+    /**
+     * Checks the card presence (typically ReaderSpi::checkCardPresence).
+     *
+     * @since 2.1.0
+     */
+    using PresenceProbe = std::function<bool()>;
+
+    /**
+     * @param presenceProbe The card presence check.
+     * @param minPollingInterval The polling interval during activity.
+     * @param maxPollingInterval The polling interval when idle.
+     * @param activityDuration The duration of the fast polling after an activity.
+     * @throw IllegalArgumentException If the intervals are not positive or not ordered.
+     * @since 2.1.0
+     */
+    explicit AdaptiveCardDetector(
+        const PresenceProbe& presenceProbe,
+        const std::chrono::microseconds& minPollingInterval = std::chrono::milliseconds(2),
+        const std::chrono::microseconds& maxPollingInterval = std::chrono::milliseconds(100),
+        const std::chrono::milliseconds& activityDuration = std::chrono::milliseconds(2000))
+    : mPresenceProbe(presenceProbe),
+      mMinPollingInterval(minPollingInterval),
+      mMaxPollingInterval(maxPollingInterval),
+      mActivityDuration(activityDuration),
+      mPollingInterval(minPollingInterval),
+      mLastActivity(std::chrono::steady_clock::now()),
+      mActivityCount(0),
+      mStopEpoch(0),
+      mHandledStopEpoch(0),
+      mPollCount(0)
+    {
+        if (minPollingInterval.count() <= 0 || maxPollingInterval < minPollingInterval) {
+            throw IllegalArgumentException("Invalid polling intervals");
+        }
+    }
+
+    /**
+     * Waits until a card is present.
+     *
+     * @throw ReaderIOException If the presence check has failed.
+     * @throw TaskCanceledException If the wait has been stopped with {@link #stop()}.
+     * @since 2.1.0
+     */
+    void waitForCardInsertion()
+    {
+        if (waitForCardPresenceUntil(true, std::chrono::steady_clock::time_point::max()) !=
+            WaitStatus::COMPLETED) {
+            throw TaskCanceledException(0, "The wait for the card has been stopped");
+        }
+    }
+
+    /**
+     * Waits until a card is present, until the provided deadline at most.
+     *
+     * @param deadline The point in time after which the wait gives up.
+     * @return The outcome of the wait.
+     * @throw ReaderIOException If the presence check has failed.
+     * @since 2.1.0
+     */
+    WaitStatus waitForCardInsertionUntil(const std::chrono::steady_clock::time_point& deadline)
+    {
+        return waitForCardPresenceUntil(true, deadline);
+    }
+
+    /**
+     * Waits until no card is present.
+     *
+     * @throw ReaderIOException If the presence check has failed.
+     * @throw TaskCanceledException If the wait has been stopped with {@link #stop()}.
+     * @since 2.1.0
+     */
+    void waitForCardRemoval()
+    {
+        if (waitForCardPresenceUntil(false, std::chrono::steady_clock::time_point::max()) !=
+            WaitStatus::COMPLETED) {
+            throw TaskCanceledException(0, "The wait for the card has been stopped");
+        }
+    }
+
+    /**
+     * Waits until no card is present, until the provided deadline at most.
+     *
+     * @param deadline The point in time after which the wait gives up.
+     * @return The outcome of the wait.
+     * @throw ReaderIOException If the presence check has failed.
+     * @since 2.1.0
+     */
+    WaitStatus waitForCardRemovalUntil(const std::chrono::steady_clock::time_point& deadline)
+    {
+        return waitForCardPresenceUntil(false, deadline);
+    }
+
+    /**
+     * Interrupts the current wait, or the next one if no wait is in progress.
+     *
+     * @since 2.1.0
+     */
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mStopEpoch++;
+        mCondition.notify_all();
+    }
+
+    /**
+     * Switches to fast polling, polling immediately if a wait is in progress.
+     *
+     * @since 2.1.0
+     */
+    void signalActivity()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        onActivity(std::chrono::steady_clock::now());
+        mCondition.notify_all();
+    }
+
+    /**
+     * Gets the current polling interval.
+     *
+     * @return A positive duration.
+     * @since 2.1.0
+     */
+    std::chrono::microseconds getPollingInterval() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPollingInterval;
+    }
+
+    /**
+     * Gets the number of presence checks performed since the creation of the detector.
+     *
+     * @return A positive number.
+     * @since 2.1.0
+     */
+    uint64_t getPollCount() const
+    {
+        return mPollCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the measured detection latencies of the card insertions.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const LatencyHistogram& getDetectionLatencies() const
+    {
+        return mDetectionLatencies;
+    }
+
+private:
+    /**
+     *
+     */
+    const PresenceProbe mPresenceProbe;
+
+    /**
+     *
+     */
+    const std::chrono::microseconds mMinPollingInterval;
+
+    /**
+     *
+     */
+    const std::chrono::microseconds mMaxPollingInterval;
+
+    /**
+     *
+     */
+    const std::chrono::milliseconds mActivityDuration;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mPollingInterval;
+
+    /**
+     *
+     */
+    std::chrono::steady_clock::time_point mLastActivity;
+
+    /**
+     * Incremented on each activity, to wake up the waiting poller.
+     */
+    uint64_t mActivityCount;
+
+    /**
+     * Incremented on each stop request.
+     */
+    uint64_t mStopEpoch;
+
+    /**
+     * Stop epoch already reported by a canceled wait; the stop requests beyond it are pending.
+     */
+    uint64_t mHandledStopEpoch;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mPollCount;
+
+    /**
+     *
+     */
+    LatencyHistogram mDetectionLatencies;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     *
+     */
+    std::condition_variable mCondition;
+
+    /**
+     * Must be invoked with the lock held.
+     */
+    void onActivity(const std::chrono::steady_clock::time_point& now)
+    {
+        mLastActivity = now;
+        mPollingInterval = mMinPollingInterval;
+        mActivityCount++;
+    }
+
+    /**
+     * Consumes the pending stop requests, if any. Must be invoked with the lock held.
+     */
+    bool consumeStopRequest()
+    {
+        if (mStopEpoch == mHandledStopEpoch) {
+            return false;
+        }
+
+        mHandledStopEpoch = mStopEpoch;
+
+        return true;
+    }
+
+    /**
+     *
+     */
+    WaitStatus waitForCardPresenceUntil(const bool isCardPresent,
+                                        const std::chrono::steady_clock::time_point& deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (consumeStopRequest()) {
+                return WaitStatus::CANCELED;
+            }
+        }
+
+        bool hasPolledWithoutSuccess = false;
+        std::chrono::steady_clock::time_point lastPoll;
+
+        while (true) {
+            const bool isPresent = mPresenceProbe();
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            mPollCount.fetch_add(1, std::memory_order_relaxed);
+
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            if (isPresent == isCardPresent) {
+                if (isCardPresent && hasPolledWithoutSuccess) {
+                    mDetectionLatencies.record(now - lastPoll);
+                }
+                if (!isCardPresent) {
+                    /* A new card is likely to be presented soon */
+                    onActivity(now);
+                }
+                return WaitStatus::COMPLETED;
+            }
+
+            if (now >= deadline) {
+                return WaitStatus::TIMED_OUT;
+            }
+
+            hasPolledWithoutSuccess = true;
+            lastPoll = now;
+
+            if (now - mLastActivity >= mActivityDuration) {
+                mPollingInterval = std::min(2 * mPollingInterval, mMaxPollingInterval);
+            }
+
+            const uint64_t activityCount = mActivityCount;
+            const std::chrono::nanoseconds timeout =
+                std::min<std::chrono::nanoseconds>(mPollingInterval, deadline - now);
+            mCondition.wait_for(lock, timeout, [this, activityCount] {
+                return mStopEpoch != mHandledStopEpoch || mActivityCount != activityCount;
+            });
+
+            if (consumeStopRequest()) {
+                return WaitStatus::CANCELED;
+            }
+        }
+    }
+};
+
+}
+}
+}
+}
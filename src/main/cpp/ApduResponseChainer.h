@@ -0,0 +1,299 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "CardIOException.h"
+#include "ReaderSpi.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi::reader;
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Implements the response handling required by ReaderSpi::transmitApdu on top of a raw transmit
+ * function, so that plugins do not have to implement it themselves:
+ *
+ * <ul>
+ *   <li>61xy: GET RESPONSE commands (00 C0 00 00 xy) are issued until the whole response has
+ *       been retrieved,
+ *   <li>6Cxy: the command is issued again once with Le = xy (short or extended encoding).
+ * </ul>
+ *
+ * <p>The response fragments are either received directly at their final position in the output
+ * buffer, without intermediate copy, or streamed one by one to a sink through a single fragment
+ * buffer (to implement ReaderSpi::transmitApduStreaming with constant memory). Internal buffers
+ * are allocated once.
+ *
+ * <p>Instances are not thread-safe; a plugin typically owns one per reader.
+ *
+ * @since 2.1.0
+ */
+class ApduResponseChainer final {
+public:
+    /**
+     * Raw exchange with the card, without any 61xy/6Cxy processing: sends apduInLength bytes and
+     * writes the response (data and status word) into apduOut, returning its length.
+     *
+     * @since 2.1.0
+     */
+    using RawTransmitter = std::function<std::size_t(const uint8_t* apduIn,
+                                                     std::size_t apduInLength,
+                                                     uint8_t* apduOut,
+                                                     std::size_t apduOutCapacity)>;
+
+    /**
+     * Maximum length of an extended response (65536 data bytes and the status word).
+     *
+     * @since 2.1.0
+     */
+    static const std::size_t MAX_RESPONSE_LENGTH = 65538;
+
+    /**
+     * @param rawTransmitter The raw exchange function of the reader.
+     * @param maxGetResponseCount The maximum number of GET RESPONSE commands for one APDU.
+     * @since 2.1.0
+     */
+    explicit ApduResponseChainer(const RawTransmitter& rawTransmitter,
+                                 const std::size_t maxGetResponseCount = 256)
+    : mRawTransmitter(rawTransmitter), mMaxGetResponseCount(maxGetResponseCount)
+    {
+        mCommand.reserve(261);
+    }
+
+    /**
+     * Transmits an APDU and writes its complete response into the provided buffer.
+     *
+     * @param apduIn The data to be sent to the card.
+     * @param apduInLength The number of bytes to send.
+     * @param apduOut The buffer receiving the complete card response.
+     * @param apduOutCapacity The size of the response buffer.
+     * @return The number of bytes written into apduOut (at least 2).
+     * @throw IllegalArgumentException If the response does not fit into the provided buffer.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @throw CardIOException If the communication with the card has failed or if the card keeps
+     *        answering 61xy.
+     * @since 2.1.0
+     */
+    std::size_t transmit(const uint8_t* apduIn,
+                         const std::size_t apduInLength,
+                         uint8_t* apduOut,
+                         const std::size_t apduOutCapacity)
+    {
+        std::size_t length = exchangeWithLe(apduIn, apduInLength, apduOut, apduOutCapacity);
+        std::size_t offset = 0;
+        std::size_t getResponseCount = 0;
+
+        while (apduOut[offset + length - 2] == 0x61) {
+            if (++getResponseCount > mMaxGetResponseCount) {
+                throw CardIOException(0, "Too many GET RESPONSE commands");
+            }
+
+            const uint8_t getResponse[] = {0x00, 0xC0, 0x00, 0x00, apduOut[offset + length - 1]};
+
+            /* The next fragment overwrites the status word of the current one */
+            offset += length - 2;
+            length = exchange(getResponse,
+                              sizeof(getResponse),
+                              apduOut + offset,
+                              apduOutCapacity - offset);
+        }
+
+        return offset + length;
+    }
+
+    /**
+     * Transmits an APDU and delivers its response data to the provided sink, fragment by fragment
+     * as they are retrieved with GET RESPONSE.
+     *
+     * @param apduIn The data to be sent to the card.
+     * @param apduInLength The number of bytes to send.
+     * @param responseData The sink receiving the response data (without status word), empty if no
+     *     response data is expected, in which case any received data is dropped.
+     * @return The final status word.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @throw CardIOException If the communication with the card has failed or if the card keeps
+     *        answering 61xy.
+     * @since 2.1.0
+     */
+    int transmit(const uint8_t* apduIn,
+                 const std::size_t apduInLength,
+                 const ReaderSpi::ApduChunkSink& responseData)
+    {
+        mFragment.resize(MAX_RESPONSE_LENGTH);
+
+        std::size_t length =
+            exchangeWithLe(apduIn, apduInLength, mFragment.data(), mFragment.size());
+        std::size_t getResponseCount = 0;
+
+        while (mFragment[length - 2] == 0x61) {
+            if (++getResponseCount > mMaxGetResponseCount) {
+                throw CardIOException(0, "Too many GET RESPONSE commands");
+            }
+
+            const uint8_t getResponse[] = {0x00, 0xC0, 0x00, 0x00, mFragment[length - 1]};
+
+            if (length > 2 && responseData) {
+                responseData(mFragment.data(), length - 2);
+            }
+
+            length = exchange(getResponse, sizeof(getResponse), mFragment.data(), mFragment.size());
+        }
+
+        if (length > 2 && responseData) {
+            responseData(mFragment.data(), length - 2);
+        }
+
+        return (mFragment[length - 2] << 8) | mFragment[length - 1];
+    }
+
+    /**
+     * Transmits an APDU and returns its complete response, to implement ReaderSpi::transmitApdu.
+     *
+     * @param apduIn The data to be sent to the card.
+     * @return A buffer of at least 2 bytes.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @throw CardIOException If the communication with the card has failed.
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> transmit(const std::vector<uint8_t>& apduIn)
+    {
+        mFragment.resize(MAX_RESPONSE_LENGTH);
+
+        const std::size_t length =
+            transmit(apduIn.data(), apduIn.size(), mFragment.data(), mFragment.size());
+
+        return std::vector<uint8_t>(mFragment.begin(), mFragment.begin() + length);
+    }
+
+private:
+    /**
+     *
+     */
+    const RawTransmitter mRawTransmitter;
+
+    /**
+     *
+     */
+    const std::size_t mMaxGetResponseCount;
+
+    /**
+     * Command rewritten with a new Le.
+     */
+    std::vector<uint8_t> mCommand;
+
+    /**
+     * Response buffer of the vector-based and streaming transmits.
+     */
+    std::vector<uint8_t> mFragment;
+
+    /**
+     *
+     */
+    std::size_t exchange(const uint8_t* apduIn,
+                         const std::size_t apduInLength,
+                         uint8_t* apduOut,
+                         const std::size_t apduOutCapacity)
+    {
+        if (apduOutCapacity < 2) {
+            throw IllegalArgumentException("Response buffer too small");
+        }
+
+        const std::size_t length = mRawTransmitter(apduIn, apduInLength, apduOut, apduOutCapacity);
+        if (length < 2) {
+            throw CardIOException(0, "Card response shorter than a status word");
+        }
+
+        return length;
+    }
+
+    /**
+     * Exchanges the command, issuing it again with the expected Le on 6Cxy.
+     */
+    std::size_t exchangeWithLe(const uint8_t* apduIn,
+                               const std::size_t apduInLength,
+                               uint8_t* apduOut,
+                               const std::size_t apduOutCapacity)
+    {
+        const std::size_t length = exchange(apduIn, apduInLength, apduOut, apduOutCapacity);
+
+        if (apduOut[length - 2] != 0x6C) {
+            return length;
+        }
+
+        setLe(apduIn, apduInLength, apduOut[length - 1]);
+
+        return exchange(mCommand.data(), mCommand.size(), apduOut, apduOutCapacity);
+    }
+
+    /**
+     * Copies the command into mCommand, replacing or appending its Le field (ISO7816-4 cases
+     * 1 to 4, short and extended).
+     */
+    void setLe(const uint8_t* apduIn, const std::size_t apduInLength, const uint8_t le)
+    {
+        mCommand.assign(apduIn, apduIn + apduInLength);
+
+        if (apduInLength <= 4) {
+            /* Case 1 */
+            mCommand.push_back(le);
+
+        } else if (apduInLength == 5) {
+            /* Case 2S */
+            mCommand[4] = le;
+
+        } else if (apduIn[4] != 0) {
+            /* Case 3S or 4S */
+            if (apduInLength == 5u + apduIn[4]) {
+                mCommand.push_back(le);
+            } else {
+                mCommand.back() = le;
+            }
+
+        } else if (apduInLength == 7) {
+            /* Case 2E */
+            mCommand[5] = 0x00;
+            mCommand[6] = le;
+
+        } else {
+            /* Case 3E or 4E */
+            const std::size_t lc = (static_cast<std::size_t>(apduIn[5]) << 8) | apduIn[6];
+            if (apduInLength == 7 + lc) {
+                mCommand.push_back(0x00);
+                mCommand.push_back(le);
+            } else {
+                mCommand[apduInLength - 2] = 0x00;
+                mCommand[apduInLength - 1] = le;
+            }
+        }
+    }
+};
+
+}
+}
+}
+}
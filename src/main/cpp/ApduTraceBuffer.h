@@ -0,0 +1,374 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/* Plugin */
+#include "ApduTraceRecord.h"
+
+/* Util */
+#include "IllegalStateException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Fixed-size ring buffer of binary trace records (see ApduTraceRecord for the record encoding).
+ *
+ * <p>When the buffer is full, the oldest records are dropped, so that the buffer always holds the
+ * latest events of the reader. Recording does not allocate.
+ *
+ * <p>The buffer can be flushed at any time to a file: a snapshot is taken, then written through a
+ * memory mapping (a plain write on Windows) while the recording goes on. The file layout is:
+ * "KTRC", version (1 byte), start time in microseconds since the Unix epoch (8 bytes,
+ * little-endian), reader name length (LEB128), reader name, number of dropped records (LEB128),
+ * then the records from the oldest. Use ApduTraceDecoder to read it back.
+ *
+ * <p>All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class ApduTraceBuffer final {
+public:
+    /**
+     * Version of the file format.
+     *
+     * @since 2.1.0
+     */
+    enum : uint8_t {
+        FORMAT_VERSION = 1
+    };
+
+    /**
+     * @param readerName The name of the traced reader.
+     * @param capacity The size of the ring buffer in bytes.
+     * @since 2.1.0
+     */
+    explicit ApduTraceBuffer(const std::string& readerName, const std::size_t capacity = 1 << 20)
+    : mReaderName(readerName),
+      mStartTime(std::chrono::steady_clock::now()),
+      mStartTimeSinceEpoch(std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::system_clock::now().time_since_epoch()).count()),
+      mBuffer(capacity),
+      mTail(0),
+      mSize(0),
+      mDroppedRecordCount(0) {}
+
+    /**
+     * Records an event.
+     *
+     * <p>A record larger than the whole buffer is dropped.
+     *
+     * @param type The type of record.
+     * @param payload The payload (may be null if payloadLength is 0).
+     * @param payloadLength The number of bytes of the payload.
+     * @since 2.1.0
+     */
+    void record(const ApduTraceRecord::Type type,
+                const uint8_t* payload,
+                const std::size_t payloadLength)
+    {
+        const uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - mStartTime).count();
+
+        uint8_t header[1 + 2 * MAX_VARINT_LENGTH];
+        std::size_t headerLength = 0;
+        header[headerLength++] = static_cast<uint8_t>(type);
+        headerLength += writeVarint(timestamp, header + headerLength);
+        headerLength += writeVarint(payloadLength, header + headerLength);
+
+        const std::size_t recordLength = headerLength + payloadLength;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (recordLength > mBuffer.size()) {
+            mDroppedRecordCount++;
+            return;
+        }
+
+        while (mBuffer.size() - mSize < recordLength) {
+            dropOldestRecord();
+        }
+
+        write(header, headerLength);
+        if (payloadLength != 0) {
+            write(payload, payloadLength);
+        }
+    }
+
+    /**
+     * Records an event without payload.
+     *
+     * @param type The type of record.
+     * @since 2.1.0
+     */
+    void record(const ApduTraceRecord::Type type)
+    {
+        record(type, nullptr, 0);
+    }
+
+    /**
+     * Gets the number of records dropped since the creation of the buffer.
+     *
+     * @since 2.1.0
+     */
+    uint64_t getDroppedRecordCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mDroppedRecordCount;
+    }
+
+    /**
+     * Gets the trace in the file format.
+     *
+     * @return A not empty buffer.
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> serialize() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::vector<uint8_t> trace(getSerializedSize());
+        serializeTo(trace.data());
+
+        return trace;
+    }
+
+    /**
+     * Writes the trace to a file, replacing its content.
+     *
+     * @param path The path of the file.
+     * @throw IllegalStateException If the file cannot be written.
+     * @since 2.1.0
+     */
+    void flushToFile(const std::string& path) const
+    {
+        /* The file is written without holding the lock, not to block the recording threads */
+        const std::vector<uint8_t> trace = serialize();
+        const std::size_t size = trace.size();
+
+#if defined(_WIN32)
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            throw IllegalStateException("Unable to create trace file " + path);
+        }
+
+        const bool isWritten = std::fwrite(trace.data(), 1, size, file) == size;
+        std::fclose(file);
+        if (!isWritten) {
+            throw IllegalStateException("Unable to write trace file " + path);
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw IllegalStateException("Unable to create trace file " + path);
+        }
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            throw IllegalStateException("Unable to size trace file " + path);
+        }
+
+        void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw IllegalStateException("Unable to map trace file " + path);
+        }
+
+        std::memcpy(mapping, trace.data(), size);
+
+        const bool isSynced = ::msync(mapping, size, MS_SYNC) == 0;
+        ::munmap(mapping, size);
+        ::close(fd);
+        if (!isSynced) {
+            throw IllegalStateException("Unable to write trace file " + path);
+        }
+#endif
+    }
+
+    /**
+     * Writes an unsigned LEB128 integer.
+     *
+     * @param value The value to write.
+     * @param dest Where to write, at least MAX_VARINT_LENGTH bytes.
+     * @return The number of bytes written.
+     * @since 2.1.0
+     */
+    static std::size_t writeVarint(uint64_t value, uint8_t* dest)
+    {
+        std::size_t length = 0;
+
+        while (value >= 0x80) {
+            dest[length++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        dest[length++] = static_cast<uint8_t>(value);
+
+        return length;
+    }
+
+private:
+    /**
+     *
+     */
+    enum : std::size_t {
+        MAX_VARINT_LENGTH = 10,
+        FILE_HEADER_LENGTH = 4 + 1 + 8
+    };
+
+    /**
+     *
+     */
+    const std::string mReaderName;
+
+    /**
+     *
+     */
+    const std::chrono::steady_clock::time_point mStartTime;
+
+    /**
+     *
+     */
+    const uint64_t mStartTimeSinceEpoch;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mBuffer;
+
+    /**
+     * Position of the oldest record.
+     */
+    std::size_t mTail;
+
+    /**
+     * Number of bytes used.
+     */
+    std::size_t mSize;
+
+    /**
+     *
+     */
+    uint64_t mDroppedRecordCount;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     *
+     */
+    void write(const uint8_t* data, const std::size_t length)
+    {
+        const std::size_t head = (mTail + mSize) % mBuffer.size();
+        const std::size_t firstPart = std::min(length, mBuffer.size() - head);
+
+        std::memcpy(&mBuffer[head], data, firstPart);
+        std::memcpy(&mBuffer[0], data + firstPart, length - firstPart);
+
+        mSize += length;
+    }
+
+    /**
+     *
+     */
+    uint64_t readVarint(std::size_t& offset) const
+    {
+        uint64_t value = 0;
+        unsigned int shift = 0;
+        uint8_t byte;
+
+        do {
+            byte = mBuffer[(mTail + offset++) % mBuffer.size()];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        return value;
+    }
+
+    /**
+     *
+     */
+    void dropOldestRecord()
+    {
+        /* Skips the type and the timestamp, then the payload */
+        std::size_t offset = 1;
+        readVarint(offset);
+        const std::size_t payloadLength = static_cast<std::size_t>(readVarint(offset));
+        const std::size_t recordLength = offset + payloadLength;
+
+        mTail = (mTail + recordLength) % mBuffer.size();
+        mSize -= recordLength;
+        mDroppedRecordCount++;
+    }
+
+    /**
+     *
+     */
+    std::size_t getSerializedSize() const
+    {
+        uint8_t varint[MAX_VARINT_LENGTH];
+
+        return FILE_HEADER_LENGTH + writeVarint(mReaderName.size(), varint) + mReaderName.size() +
+               writeVarint(mDroppedRecordCount, varint) + mSize;
+    }
+
+    /**
+     *
+     */
+    void serializeTo(uint8_t* dest) const
+    {
+        std::memcpy(dest, "KTRC", 4);
+        dest += 4;
+        *dest++ = FORMAT_VERSION;
+        for (int i = 0; i < 8; i++) {
+            *dest++ = static_cast<uint8_t>(mStartTimeSinceEpoch >> (8 * i));
+        }
+
+        dest += writeVarint(mReaderName.size(), dest);
+        std::memcpy(dest, mReaderName.data(), mReaderName.size());
+        dest += mReaderName.size();
+        dest += writeVarint(mDroppedRecordCount, dest);
+
+        const std::size_t firstPart = std::min(mSize, mBuffer.size() - mTail);
+        std::memcpy(dest, &mBuffer[mTail], firstPart);
+        std::memcpy(dest + firstPart, &mBuffer[0], mSize - firstPart);
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,204 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ApduTraceBuffer.h"
+#include "ApduTraceRecord.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Offline decoder of the traces written by ApduTraceBuffer.
+ *
+ * @since 2.1.0
+ */
+class ApduTraceDecoder final {
+public:
+    /**
+     * Decodes a trace.
+     *
+     * @param trace The trace, as returned by ApduTraceBuffer::serialize.
+     * @throw IllegalArgumentException If the trace is malformed.
+     * @since 2.1.0
+     */
+    explicit ApduTraceDecoder(const std::vector<uint8_t>& trace)
+    : mStartTime(0), mDroppedRecordCount(0)
+    {
+        decode(trace.data(), trace.size());
+    }
+
+    /**
+     * Decodes a trace file.
+     *
+     * @param path The path of a file written by ApduTraceBuffer::flushToFile.
+     * @return A not null reference.
+     * @throw IllegalArgumentException If the file cannot be read or is malformed.
+     * @since 2.1.0
+     */
+    static const ApduTraceDecoder fromFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw IllegalArgumentException("Unable to open trace file " + path);
+        }
+
+        const std::vector<uint8_t> trace((std::istreambuf_iterator<char>(file)),
+                                         std::istreambuf_iterator<char>());
+
+        return ApduTraceDecoder(trace);
+    }
+
+    /**
+     * @return The name of the traced reader.
+     * @since 2.1.0
+     */
+    const std::string& getReaderName() const
+    {
+        return mReaderName;
+    }
+
+    /**
+     * @return The start time of the trace in microseconds since the Unix epoch, to which the
+     *         record timestamps are relative.
+     * @since 2.1.0
+     */
+    uint64_t getStartTime() const
+    {
+        return mStartTime;
+    }
+
+    /**
+     * @return The number of records dropped before the oldest one when the trace was written.
+     * @since 2.1.0
+     */
+    uint64_t getDroppedRecordCount() const
+    {
+        return mDroppedRecordCount;
+    }
+
+    /**
+     * @return The records, from the oldest.
+     * @since 2.1.0
+     */
+    const std::vector<ApduTraceRecord>& getRecords() const
+    {
+        return mRecords;
+    }
+
+private:
+    /**
+     *
+     */
+    std::string mReaderName;
+
+    /**
+     *
+     */
+    uint64_t mStartTime;
+
+    /**
+     *
+     */
+    uint64_t mDroppedRecordCount;
+
+    /**
+     *
+     */
+    std::vector<ApduTraceRecord> mRecords;
+
+    /**
+     *
+     */
+    static void require(const bool condition)
+    {
+        if (!condition) {
+            throw IllegalArgumentException("Malformed APDU trace");
+        }
+    }
+
+    /**
+     *
+     */
+    static uint64_t readVarint(const uint8_t* data, const std::size_t size, std::size_t& offset)
+    {
+        uint64_t value = 0;
+        unsigned int shift = 0;
+        uint8_t byte;
+
+        do {
+            require(offset < size && shift < 64);
+            byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        return value;
+    }
+
+    /**
+     *
+     */
+    void decode(const uint8_t* data, const std::size_t size)
+    {
+        require(size >= 13 &&
+                data[0] == 'K' && data[1] == 'T' && data[2] == 'R' && data[3] == 'C' &&
+                data[4] == ApduTraceBuffer::FORMAT_VERSION);
+
+        for (int i = 0; i < 8; i++) {
+            mStartTime |= static_cast<uint64_t>(data[5 + i]) << (8 * i);
+        }
+
+        std::size_t offset = 13;
+        const uint64_t readerNameLength = readVarint(data, size, offset);
+        require(readerNameLength <= size - offset);
+        mReaderName.assign(reinterpret_cast<const char*>(data + offset),
+                           static_cast<std::size_t>(readerNameLength));
+        offset += static_cast<std::size_t>(readerNameLength);
+
+        mDroppedRecordCount = readVarint(data, size, offset);
+
+        while (offset < size) {
+            const auto type = static_cast<ApduTraceRecord::Type>(data[offset++]);
+            const uint64_t timestamp = readVarint(data, size, offset);
+            const uint64_t payloadLength = readVarint(data, size, offset);
+            require(payloadLength <= size - offset);
+
+            mRecords.push_back(
+                ApduTraceRecord(type,
+                                timestamp,
+                                std::vector<uint8_t>(data + offset,
+                                                     data + offset + payloadLength)));
+            offset += static_cast<std::size_t>(payloadLength);
+        }
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,130 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+/**
+ * Event of a card session recorded by a TracingReaderSpi and decoded by ApduTraceDecoder.
+ *
+ * <p>Binary encoding of a record: type (1 byte), timestamp in microseconds since the start of the
+ * trace (unsigned LEB128), payload length (unsigned LEB128), payload.
+ *
+ * @since 2.1.0
+ */
+class ApduTraceRecord final {
+public:
+    /**
+     * Type of record, with the content of its payload.
+     *
+     * @since 2.1.0
+     */
+    enum class Type : uint8_t {
+        /** Physical channel opened; payload: the raw power-on data if known. */
+        CHANNEL_OPENED = 0x01,
+        /** Physical channel closed; no payload. */
+        CHANNEL_CLOSED = 0x02,
+        /** Card presence checked; payload: 1 if present, 0 if not. */
+        CARD_PRESENCE = 0x03,
+        /** APDU sent to the card; payload: the command. */
+        COMMAND = 0x10,
+        /** APDU received from the card; payload: the response. */
+        RESPONSE = 0x11,
+        /** Streamed exchange started; payload: CLA, INS, P1, P2. */
+        STREAM_STARTED = 0x12,
+        /** Command data of a streamed exchange; payload: the chunk. */
+        COMMAND_CHUNK = 0x13,
+        /** Response data of a streamed exchange; payload: the chunk. */
+        RESPONSE_CHUNK = 0x14,
+        /** Streamed exchange completed; payload: the status word. */
+        STREAM_ENDED = 0x15,
+        /** Operation failed; payload: the ErrorCategory (1 byte), then the exception message. */
+        ERROR = 0x20
+    };
+
+    /**
+     * Category of a failed operation, first byte of the payload of an ERROR record.
+     *
+     * @since 2.1.0
+     */
+    enum class ErrorCategory : uint8_t {
+        /** Any other exception. */
+        OTHER = 0x00,
+        /** ReaderIOException. */
+        READER_IO = 0x01,
+        /** CardIOException. */
+        CARD_IO = 0x02
+    };
+
+    /**
+     * @param type The type of record.
+     * @param timestamp The time of the event in microseconds since the start of the trace.
+     * @param payload The payload.
+     * @since 2.1.0
+     */
+    ApduTraceRecord(const Type type, const uint64_t timestamp, const std::vector<uint8_t>& payload)
+    : mType(type), mTimestamp(timestamp), mPayload(payload) {}
+
+    /**
+     * @return The type of record.
+     * @since 2.1.0
+     */
+    Type getType() const
+    {
+        return mType;
+    }
+
+    /**
+     * @return The time of the event in microseconds since the start of the trace.
+     * @since 2.1.0
+     */
+    uint64_t getTimestamp() const
+    {
+        return mTimestamp;
+    }
+
+    /**
+     * @return The payload, possibly empty.
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t>& getPayload() const
+    {
+        return mPayload;
+    }
+
+private:
+    /**
+     *
+     */
+    Type mType;
+
+    /**
+     *
+     */
+    uint64_t mTimestamp;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mPayload;
+};
+
+}
+}
+}
+}
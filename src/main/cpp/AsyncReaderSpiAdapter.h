@@ -0,0 +1,215 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "AsyncReaderSpi.h"
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Exposes a synchronous {@link ReaderSpi} as an {@link AsyncReaderSpi}.
+ *
+ * <p>Each operation is handed over to the provided executor, which runs it (typically on a worker
+ * thread) and then invokes the completion callback. Without executor, operations run on the
+ * calling thread and their callback is invoked before the method returns.
+ *
+ * @since 2.1.0
+ */
+class AsyncReaderSpiAdapter final : public AsyncReaderSpi {
+public:
+    /**
+     * Runs a task, immediately or later, on any thread.
+     *
+     * @since 2.1.0
+     */
+    using Executor = std::function<void(const std::function<void()>& task)>;
+
+    /**
+     * Creates an adapter running the operations on the calling thread.
+     *
+     * @param readerSpi The synchronous reader to adapt.
+     * @since 2.1.0
+     */
+    explicit AsyncReaderSpiAdapter(std::shared_ptr<ReaderSpi> readerSpi)
+    : AsyncReaderSpiAdapter(readerSpi, [](const std::function<void()>& task) { task(); }) {}
+
+    /**
+     * @param readerSpi The synchronous reader to adapt.
+     * @param executor The executor running the operations.
+     * @since 2.1.0
+     */
+    AsyncReaderSpiAdapter(std::shared_ptr<ReaderSpi> readerSpi, const Executor& executor)
+    : mReaderSpi(readerSpi), mExecutor(executor) {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mReaderSpi->getName();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void openPhysicalChannel(const CompletionCallback& callback) override
+    {
+        std::shared_ptr<ReaderSpi> readerSpi = mReaderSpi;
+
+        mExecutor([readerSpi, callback]() {
+            std::exception_ptr error;
+            try {
+                readerSpi->openPhysicalChannel();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            callback(error);
+        });
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void closePhysicalChannel(const CompletionCallback& callback) override
+    {
+        std::shared_ptr<ReaderSpi> readerSpi = mReaderSpi;
+
+        mExecutor([readerSpi, callback]() {
+            std::exception_ptr error;
+            try {
+                readerSpi->closePhysicalChannel();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            callback(error);
+        });
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isPhysicalChannelOpen() const override
+    {
+        return mReaderSpi->isPhysicalChannelOpen();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void checkCardPresence(const CardPresenceCallback& callback) override
+    {
+        std::shared_ptr<ReaderSpi> readerSpi = mReaderSpi;
+
+        mExecutor([readerSpi, callback]() {
+            bool isCardPresent = false;
+            std::exception_ptr error;
+            try {
+                isCardPresent = readerSpi->checkCardPresence();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            callback(isCardPresent, error);
+        });
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string getPowerOnData() const override
+    {
+        return mReaderSpi->getPowerOnData();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void transmitApdu(const std::vector<uint8_t>& apduIn,
+                      const TransmitApduCallback& callback) override
+    {
+        std::shared_ptr<ReaderSpi> readerSpi = mReaderSpi;
+
+        mExecutor([readerSpi, apduIn, callback]() {
+            std::vector<uint8_t> apduOut;
+            std::exception_ptr error;
+            try {
+                apduOut = readerSpi->transmitApdu(apduIn);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            callback(apduOut, error);
+        });
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() override
+    {
+        return mReaderSpi->isContactless();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override
+    {
+        mReaderSpi->onUnregister();
+    }
+
+private:
+    /**
+     *
+     */
+    const std::shared_ptr<ReaderSpi> mReaderSpi;
+
+    /**
+     *
+     */
+    const Executor mExecutor;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,203 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "AsyncReaderSpi.h"
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Exposes an {@link AsyncReaderSpi} as a synchronous {@link ReaderSpi}.
+ *
+ * <p>Each operation blocks the calling thread until the completion callback is invoked, then
+ * returns its result or rethrows the reported exception.
+ *
+ * <p>The callbacks must not be invoked on the thread blocked by this adapter (for example, by an
+ * event loop running on the caller's thread), otherwise the call never returns.
+ *
+ * @since 2.1.0
+ */
+class BlockingReaderSpiAdapter final : public ReaderSpi {
+public:
+    /**
+     * @param asyncReaderSpi The asynchronous reader to adapt.
+     * @since 2.1.0
+     */
+    explicit BlockingReaderSpiAdapter(std::shared_ptr<AsyncReaderSpi> asyncReaderSpi)
+    : mAsyncReaderSpi(asyncReaderSpi) {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mAsyncReaderSpi->getName();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void openPhysicalChannel() override
+    {
+        auto promise = std::make_shared<std::promise<void>>();
+        std::future<void> future = promise->get_future();
+
+        mAsyncReaderSpi->openPhysicalChannel([promise](std::exception_ptr error) {
+            complete(*promise, error);
+        });
+
+        future.get();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void closePhysicalChannel() override
+    {
+        auto promise = std::make_shared<std::promise<void>>();
+        std::future<void> future = promise->get_future();
+
+        mAsyncReaderSpi->closePhysicalChannel([promise](std::exception_ptr error) {
+            complete(*promise, error);
+        });
+
+        future.get();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isPhysicalChannelOpen() const override
+    {
+        return mAsyncReaderSpi->isPhysicalChannelOpen();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool checkCardPresence() override
+    {
+        auto promise = std::make_shared<std::promise<bool>>();
+        std::future<bool> future = promise->get_future();
+
+        mAsyncReaderSpi->checkCardPresence(
+            [promise](bool isCardPresent, std::exception_ptr error) {
+                if (error) {
+                    promise->set_exception(error);
+                } else {
+                    promise->set_value(isCardPresent);
+                }
+            });
+
+        return future.get();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string getPowerOnData() const override
+    {
+        return mAsyncReaderSpi->getPowerOnData();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override
+    {
+        auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+        std::future<std::vector<uint8_t>> future = promise->get_future();
+
+        mAsyncReaderSpi->transmitApdu(
+            apduIn,
+            [promise](const std::vector<uint8_t>& apduOut, std::exception_ptr error) {
+                if (error) {
+                    promise->set_exception(error);
+                } else {
+                    promise->set_value(apduOut);
+                }
+            });
+
+        return future.get();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() override
+    {
+        return mAsyncReaderSpi->isContactless();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override
+    {
+        mAsyncReaderSpi->onUnregister();
+    }
+
+private:
+    /**
+     *
+     */
+    const std::shared_ptr<AsyncReaderSpi> mAsyncReaderSpi;
+
+    /**
+     *
+     */
+    static void complete(std::promise<void>& promise, std::exception_ptr error)
+    {
+        if (error) {
+            promise.set_exception(error);
+        } else {
+            promise.set_value();
+        }
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,745 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Plugin */
+#include "MonitoredPoolPluginSpi.h"
+#include "PluginIOException.h"
+#include "PolicyAwarePoolPluginSpi.h"
+#include "ReaderGroupStatisticsRecorder.h"
+#include "TimedPoolPluginSpi.h"
+#include "WarmPoolPluginSpi.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi;
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Reference implementation of the reader allocation of a pool plugin, to be inherited by plugins
+ * which only have to provide their name, their readers and {@link #onUnregister()}.
+ *
+ * <p>Each reader group has its own lock, held only for the few instructions updating its free
+ * readers, so that allocations in different groups never contend and allocations in the same group
+ * contend briefly. Finding the group of a released reader does not lock at all.
+ *
+ * <p>Waiting is fair: a caller waiting for a reader of a group (blocking, timed or asynchronous) is
+ * served before any later caller, the released reader being handed over directly to the longest
+ * waiting one.
+ *
+ * <p>Each group can keep some free readers warm, with their physical channel open (see
+ * WarmPoolPluginSpi): they are allocated first, and a released reader whose channel is still open
+ * is kept warm while the warm pool of its group is not full. The readers are warmed up by
+ * {@link #setWarmPoolSize()}, on the calling thread.
+ *
+ * <p>The set of groups and readers is fixed at construction. All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class ConcurrentPoolPluginSpi : public TimedPoolPluginSpi,
+                                public MonitoredPoolPluginSpi,
+                                public PolicyAwarePoolPluginSpi,
+                                public WarmPoolPluginSpi {
+public:
+    /**
+     * @param readers The readers of each group.
+     * @throw IllegalArgumentException If a reader is null or belongs to several groups.
+     * @since 2.1.0
+     */
+    explicit ConcurrentPoolPluginSpi(
+        const std::map<std::string, std::vector<std::shared_ptr<ReaderSpi>>>& readers)
+    {
+        for (const auto& groupReaders : readers) {
+            std::unique_ptr<Group> group(new Group(groupReaders.second));
+            for (const auto& reader : groupReaders.second) {
+                if (!reader ||
+                    !mReaderGroups.insert(std::make_pair(reader.get(), group.get())).second) {
+                    throw IllegalArgumentException("Null or duplicate reader in group '" +
+                                                   groupReaders.first + "'");
+                }
+            }
+            mGroups.insert(std::make_pair(groupReaders.first, std::move(group)));
+        }
+    }
+
+    /**
+     *
+     */
+    virtual ~ConcurrentPoolPluginSpi() = default;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::string> getReaderGroupReferences() const override
+    {
+        std::vector<std::string> readerGroupReferences;
+        readerGroupReferences.reserve(mGroups.size());
+        for (const auto& group : mGroups) {
+            readerGroupReferences.push_back(group.first);
+        }
+
+        return readerGroupReferences;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Waits until a reader of the group is free.
+     *
+     * @throw PluginIOException If the group is unknown.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> allocateReader(const std::string& readerGroupReference) override
+    {
+        return allocateReaderWithAffinity(readerGroupReference, "");
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Waits until a reader of the group is free.
+     *
+     * @throw PluginIOException If the group is unknown.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> allocateReaderWithAffinity(const std::string& readerGroupReference,
+                                                          const std::string& affinityKey) override
+    {
+        return allocate(getGroup(readerGroupReference),
+                        affinityKey,
+                        std::chrono::steady_clock::time_point::max());
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw PluginIOException If the group is unknown.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> tryAllocateReader(const std::string& readerGroupReference) override
+    {
+        return allocate(getGroup(readerGroupReference),
+                        "",
+                        std::chrono::steady_clock::time_point::min());
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw PluginIOException If the group is unknown.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> tryAllocateReaderUntil(
+        const std::string& readerGroupReference,
+        const std::chrono::steady_clock::time_point& deadline) override
+    {
+        return allocate(getGroup(readerGroupReference), "", deadline);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>When no reader is free, the callback is invoked by the thread releasing the reader handed
+     * over to this request; it must therefore be short and must not throw. A failure of the
+     * allocation policy is passed to the callback as well.
+     *
+     * @since 2.1.0
+     */
+    void allocateReaderAsync(const std::string& readerGroupReference,
+                             const AllocationCallback& callback) override
+    {
+        Group* group;
+        try {
+            group = &getGroup(readerGroupReference);
+        } catch (const PluginIOException&) {
+            callback(nullptr, std::current_exception());
+            return;
+        }
+
+        std::shared_ptr<ReaderSpi> reader;
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(group->mMutex);
+
+            if (!group->mWaiters.empty() || getFreeReaderCount(*group) == 0) {
+                auto waiter = std::make_shared<Waiter>("");
+                waiter->mCallback = callback;
+                group->mWaiters.push_back(waiter);
+                return;
+            }
+
+            try {
+                reader = takeFreeReader(*group, "", std::chrono::nanoseconds(0));
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        callback(reader, error);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Never waits: the readers must be free right now, and no caller must be already waiting for
+     * a reader of the group. If the allocation policy fails, the readers already allocated are
+     * released and the error is raised, whatever the mode.
+     *
+     * @throw PluginIOException If the group is unknown, or if not enough readers are free in
+     *        ALL_OR_NOTHING mode.
+     * @since 2.1.0
+     */
+    std::vector<std::shared_ptr<ReaderSpi>> allocateReaders(
+        const std::string& readerGroupReference,
+        const std::size_t readerCount,
+        const BulkAllocationMode mode) override
+    {
+        Group& group = getGroup(readerGroupReference);
+
+        std::vector<std::shared_ptr<ReaderSpi>> readers;
+        try {
+            std::lock_guard<std::mutex> lock(group.mMutex);
+
+            const std::size_t freeReaderCount =
+                group.mWaiters.empty() ? getFreeReaderCount(group) : 0;
+
+            if (mode == BulkAllocationMode::ALL_OR_NOTHING && freeReaderCount < readerCount) {
+                group.mStatistics.recordAllocationFailure();
+                throw PluginIOException("Not enough free readers in group '" +
+                                        readerGroupReference + "'");
+            }
+
+            readers.reserve(std::min(readerCount, freeReaderCount));
+            while (readers.size() < readerCount && readers.size() < freeReaderCount) {
+                readers.push_back(takeFreeReader(group, "", std::chrono::nanoseconds(0)));
+            }
+
+        } catch (...) {
+            /* Released once the group lock is no longer held */
+            rollBack(readers);
+            throw;
+        }
+
+        return readers;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The reader is handed over to the longest waiting caller if any. Finding its group does not
+     * lock; the group lock is then held only to update the free readers.
+     *
+     * <p>The reader is free again before the allocation policy is notified. If the policy fails to
+     * allocate it to a waiting caller, that caller receives the error and the reader is offered to
+     * the next one. A failure of the policy notification is raised once the waiting callers have
+     * been served.
+     *
+     * <p>When the warm pool of the group is enabled, a reader whose physical channel is still open
+     * is kept warm, unless the warm pool is full, in which case its channel is closed first.
+     *
+     * @throw PluginIOException If the reader does not belong to the pool or is not allocated.
+     * @since 2.1.0
+     */
+    void releaseReader(std::shared_ptr<ReaderSpi> readerSpi) override
+    {
+        const auto it = mReaderGroups.find(readerSpi.get());
+        if (it == mReaderGroups.end()) {
+            throw PluginIOException("The reader does not belong to the pool");
+        }
+        Group& group = *it->second;
+
+        std::exception_ptr releaseError;
+        const bool isChannelOpen = prepareWarmRelease(group, readerSpi, releaseError);
+
+        std::vector<std::shared_ptr<Waiter>> servedCallbacks;
+        {
+            std::lock_guard<std::mutex> lock(group.mMutex);
+
+            const auto allocation = group.mAllocationTimes.find(readerSpi.get());
+            if (allocation == group.mAllocationTimes.end()) {
+                throw PluginIOException("The reader is not allocated");
+            }
+
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            group.mStatistics.recordRelease(now - allocation->second);
+            group.mAllocationTimes.erase(allocation);
+            if (isChannelOpen && group.mWarmReaders.size() < group.mWarmPoolSize) {
+                group.mWarmReaders.push_back(readerSpi);
+            } else {
+                group.mFreeReaders.push_back(readerSpi);
+            }
+            if (group.mPolicy) {
+                try {
+                    group.mPolicy->onReaderReleased(readerSpi);
+                } catch (...) {
+                    if (!releaseError) {
+                        releaseError = std::current_exception();
+                    }
+                }
+            }
+
+            serveWaiters(group, now, servedCallbacks);
+        }
+
+        for (const auto& waiter : servedCallbacks) {
+            waiter->mCallback(waiter->mReader, waiter->mError);
+        }
+
+        if (releaseError) {
+            std::rethrow_exception(releaseError);
+        }
+    }
+
+    /**
+     * Gets the number of callers waiting for a reader of a group, blocked or asynchronous.
+     *
+     * @param readerGroupReference The reader group reference.
+     * @return A positive or zero number.
+     * @throw PluginIOException If the group is unknown.
+     * @since 2.1.0
+     */
+    std::size_t getWaiterCount(const std::string& readerGroupReference) const
+    {
+        const Group& group = getGroup(readerGroupReference);
+
+        std::lock_guard<std::mutex> lock(group.mMutex);
+
+        return group.mWaiters.size();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw IllegalArgumentException If the group reference is unknown or the policy is null.
+     * @since 2.1.0
+     */
+    void setAllocationPolicy(const std::string& readerGroupReference,
+                             std::shared_ptr<ReaderAllocationPolicySpi> allocationPolicy) override
+    {
+        const auto it = mGroups.find(readerGroupReference);
+        if (it == mGroups.end() || !allocationPolicy) {
+            throw IllegalArgumentException("Unknown reader group or null policy");
+        }
+
+        std::lock_guard<std::mutex> lock(it->second->mMutex);
+        it->second->mPolicy = allocationPolicy;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw PluginIOException If the group is unknown.
+     * @since 2.1.0
+     */
+    const ReaderGroupStatistics getReaderGroupStatistics(
+        const std::string& readerGroupReference) const override
+    {
+        const Group& group = getGroup(readerGroupReference);
+
+        std::lock_guard<std::mutex> lock(group.mMutex);
+
+        return group.mStatistics.getStatistics(group.mReaders.size(), getFreeReaderCount(group));
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The free readers are warmed up, or cooled down, on the calling thread before returning;
+     * meanwhile, they are not available for allocation. Failing to open or close a channel does
+     * not stop the operation: the first failure is raised once all the readers have been
+     * processed.
+     *
+     * @since 2.1.0
+     */
+    void setWarmPoolSize(const std::string& readerGroupReference,
+                         const std::size_t warmPoolSize) override
+    {
+        Group& group = getWarmGroup(readerGroupReference);
+
+        std::exception_ptr error;
+        std::vector<std::shared_ptr<ReaderSpi>> readers;
+        {
+            std::lock_guard<std::mutex> lock(group.mMutex);
+
+            group.mWarmPoolSize = warmPoolSize;
+            while (group.mWarmReaders.size() > warmPoolSize) {
+                readers.push_back(group.mWarmReaders.back());
+                group.mWarmReaders.pop_back();
+            }
+        }
+
+        /* Cools down the warm readers in excess */
+        for (const auto& reader : readers) {
+            try {
+                reader->closePhysicalChannel();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        putBackFreeReaders(group, readers, {});
+
+        /* Warms up cold free readers until the warm pool is full */
+        while (true) {
+            std::shared_ptr<ReaderSpi> reader;
+            {
+                std::lock_guard<std::mutex> lock(group.mMutex);
+
+                if (group.mWarmReaders.size() >= group.mWarmPoolSize ||
+                    group.mFreeReaders.empty()) {
+                    break;
+                }
+                reader = group.mFreeReaders.back();
+                group.mFreeReaders.pop_back();
+            }
+
+            bool isWarm = false;
+            try {
+                reader->openPhysicalChannel();
+                isWarm = true;
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (isWarm) {
+                putBackFreeReaders(group, {}, {reader});
+            } else {
+                putBackFreeReaders(group, {reader}, {});
+                break;
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t getWarmPoolSize(const std::string& readerGroupReference) const override
+    {
+        const Group& group = getWarmGroup(readerGroupReference);
+
+        std::lock_guard<std::mutex> lock(group.mMutex);
+
+        return group.mWarmPoolSize;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Hits and misses are only counted while the warm pool of the group is enabled.
+     *
+     * @since 2.1.0
+     */
+    const WarmPoolStatistics getWarmPoolStatistics(
+        const std::string& readerGroupReference) const override
+    {
+        const Group& group = getWarmGroup(readerGroupReference);
+
+        std::lock_guard<std::mutex> lock(group.mMutex);
+
+        return WarmPoolStatistics(
+            group.mWarmReaders.size(), group.mWarmHitCount, group.mWarmMissCount);
+    }
+
+private:
+    /**
+     * Caller waiting for a reader of a group, blocked on its condition or asynchronous.
+     */
+    struct Waiter {
+        explicit Waiter(const std::string& affinityKey)
+        : mAffinityKey(affinityKey), mStart(std::chrono::steady_clock::now()) {}
+
+        const std::string mAffinityKey;
+        const std::chrono::steady_clock::time_point mStart;
+        std::condition_variable mCondition;
+        AllocationCallback mCallback;
+        std::shared_ptr<ReaderSpi> mReader;
+        std::exception_ptr mError;
+    };
+
+    /**
+     * Readers of a group; everything but mReaders is protected by mMutex.
+     */
+    struct Group {
+        explicit Group(const std::vector<std::shared_ptr<ReaderSpi>>& readers)
+        : mReaders(readers),
+          mFreeReaders(readers),
+          mWarmPoolSize(0),
+          mWarmHitCount(0),
+          mWarmMissCount(0) {}
+
+        const std::vector<std::shared_ptr<ReaderSpi>> mReaders;
+        /* Free readers, apart from the warm ones */
+        std::vector<std::shared_ptr<ReaderSpi>> mFreeReaders;
+        /* Free readers whose physical channel is open, allocated first */
+        std::vector<std::shared_ptr<ReaderSpi>> mWarmReaders;
+        /* Atomic so that releases can skip the warm pool handling without locking */
+        std::atomic<std::size_t> mWarmPoolSize;
+        uint64_t mWarmHitCount;
+        uint64_t mWarmMissCount;
+        std::unordered_map<const ReaderSpi*, std::chrono::steady_clock::time_point>
+            mAllocationTimes;
+        std::deque<std::shared_ptr<Waiter>> mWaiters;
+        std::shared_ptr<ReaderAllocationPolicySpi> mPolicy;
+        ReaderGroupStatisticsRecorder mStatistics;
+        mutable std::mutex mMutex;
+    };
+
+    /**
+     * Immutable after construction, hence read without locking.
+     */
+    std::map<std::string, std::unique_ptr<Group>> mGroups;
+
+    /**
+     * Group of each reader; immutable after construction, hence read without locking.
+     */
+    std::unordered_map<const ReaderSpi*, Group*> mReaderGroups;
+
+    /**
+     *
+     */
+    Group& getGroup(const std::string& readerGroupReference) const
+    {
+        const auto it = mGroups.find(readerGroupReference);
+        if (it == mGroups.end()) {
+            throw PluginIOException("Unknown reader group '" + readerGroupReference + "'");
+        }
+
+        return *it->second;
+    }
+
+    /**
+     * Same as getGroup, with the exception documented by WarmPoolPluginSpi.
+     */
+    Group& getWarmGroup(const std::string& readerGroupReference) const
+    {
+        const auto it = mGroups.find(readerGroupReference);
+        if (it == mGroups.end()) {
+            throw IllegalArgumentException("Unknown reader group '" + readerGroupReference + "'");
+        }
+
+        return *it->second;
+    }
+
+    /**
+     * Must be invoked with the group lock held.
+     */
+    static std::size_t getFreeReaderCount(const Group& group)
+    {
+        return group.mFreeReaders.size() + group.mWarmReaders.size();
+    }
+
+    /**
+     * Removes a free reader selected by the policy of the group, among the warm ones if any. Must
+     * be invoked with the group lock held and at least one free reader.
+     *
+     * <p>The policy is consulted before any change, so that the group is left unchanged if it
+     * throws.
+     */
+    std::shared_ptr<ReaderSpi> takeFreeReader(Group& group,
+                                              const std::string& affinityKey,
+                                              const std::chrono::nanoseconds& waitTime)
+    {
+        const bool isWarm = !group.mWarmReaders.empty();
+        std::vector<std::shared_ptr<ReaderSpi>>& freeReaders =
+            isWarm ? group.mWarmReaders : group.mFreeReaders;
+
+        std::size_t index = freeReaders.size() - 1;
+        if (group.mPolicy) {
+            index = std::min(group.mPolicy->selectReader(freeReaders, affinityKey), index);
+        }
+
+        std::shared_ptr<ReaderSpi> reader = freeReaders[index];
+        if (group.mPolicy) {
+            group.mPolicy->onReaderAllocated(reader, affinityKey);
+        }
+
+        freeReaders[index] = freeReaders.back();
+        freeReaders.pop_back();
+
+        group.mAllocationTimes[reader.get()] = std::chrono::steady_clock::now();
+        group.mStatistics.recordAllocation(waitTime);
+        if (isWarm) {
+            group.mWarmHitCount++;
+        } else if (group.mWarmPoolSize != 0) {
+            group.mWarmMissCount++;
+        }
+
+        return reader;
+    }
+
+    /**
+     * Hands the free readers over to the longest waiting callers the policy manages to allocate
+     * a reader to. Must be invoked with the group lock held; the asynchronous callers served are
+     * added to the provided list, to be called back once the lock is released.
+     */
+    void serveWaiters(Group& group,
+                      const std::chrono::steady_clock::time_point& now,
+                      std::vector<std::shared_ptr<Waiter>>& servedCallbacks)
+    {
+        while (!group.mWaiters.empty() && getFreeReaderCount(group) != 0) {
+            const std::shared_ptr<Waiter> waiter = group.mWaiters.front();
+            group.mWaiters.pop_front();
+            try {
+                waiter->mReader = takeFreeReader(group, waiter->mAffinityKey, now - waiter->mStart);
+            } catch (...) {
+                waiter->mError = std::current_exception();
+            }
+
+            if (waiter->mCallback) {
+                servedCallbacks.push_back(waiter);
+            } else {
+                waiter->mCondition.notify_one();
+            }
+        }
+    }
+
+    /**
+     * Makes readers taken out by setWarmPoolSize free again, serving the waiting callers.
+     */
+    void putBackFreeReaders(Group& group,
+                            const std::vector<std::shared_ptr<ReaderSpi>>& coldReaders,
+                            const std::vector<std::shared_ptr<ReaderSpi>>& warmReaders)
+    {
+        std::vector<std::shared_ptr<Waiter>> servedCallbacks;
+        {
+            std::lock_guard<std::mutex> lock(group.mMutex);
+
+            group.mFreeReaders.insert(
+                group.mFreeReaders.end(), coldReaders.begin(), coldReaders.end());
+            group.mWarmReaders.insert(
+                group.mWarmReaders.end(), warmReaders.begin(), warmReaders.end());
+            serveWaiters(group, std::chrono::steady_clock::now(), servedCallbacks);
+        }
+
+        for (const auto& waiter : servedCallbacks) {
+            waiter->mCallback(waiter->mReader, waiter->mError);
+        }
+    }
+
+    /**
+     * Closes the physical channel of a released reader if the warm pool of its group is enabled
+     * but full, before it becomes free. A closing failure is stored into the provided error.
+     *
+     * @return True if the warm pool is enabled and the channel of the reader is still open.
+     */
+    bool prepareWarmRelease(Group& group,
+                            const std::shared_ptr<ReaderSpi>& readerSpi,
+                            std::exception_ptr& error)
+    {
+        if (group.mWarmPoolSize == 0) {
+            return false;
+        }
+
+        bool isFull;
+        {
+            std::lock_guard<std::mutex> lock(group.mMutex);
+
+            if (group.mAllocationTimes.find(readerSpi.get()) == group.mAllocationTimes.end()) {
+                throw PluginIOException("The reader is not allocated");
+            }
+            isFull = group.mWarmReaders.size() >= group.mWarmPoolSize;
+        }
+
+        try {
+            if (!readerSpi->isPhysicalChannelOpen()) {
+                return false;
+            }
+            if (isFull) {
+                readerSpi->closePhysicalChannel();
+                return false;
+            }
+        } catch (...) {
+            error = std::current_exception();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Allocates a reader of the group, waiting in FIFO order until the deadline if none is free.
+     */
+    std::shared_ptr<ReaderSpi> allocate(Group& group,
+                                        const std::string& affinityKey,
+                                        const std::chrono::steady_clock::time_point& deadline)
+    {
+        std::unique_lock<std::mutex> lock(group.mMutex);
+
+        if (group.mWaiters.empty() && getFreeReaderCount(group) != 0) {
+            return takeFreeReader(group, affinityKey, std::chrono::nanoseconds(0));
+        }
+
+        if (deadline == std::chrono::steady_clock::time_point::min()) {
+            group.mStatistics.recordAllocationFailure();
+            return nullptr;
+        }
+
+        auto waiter = std::make_shared<Waiter>(affinityKey);
+        group.mWaiters.push_back(waiter);
+
+        const auto isServed = [&waiter] { return waiter->mReader != nullptr || waiter->mError; };
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            waiter->mCondition.wait(lock, isServed);
+        } else {
+            waiter->mCondition.wait_until(lock, deadline, isServed);
+        }
+
+        if (waiter->mError) {
+            std::rethrow_exception(waiter->mError);
+        }
+
+        if (!waiter->mReader) {
+            group.mWaiters.erase(std::find(group.mWaiters.begin(), group.mWaiters.end(), waiter));
+            group.mStatistics.recordAllocationFailure();
+        }
+
+        return waiter->mReader;
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,441 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "LatencyHistogram.h"
+#include "ReaderMetrics.h"
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Decorator of a {@link ReaderSpi} measuring the latency, the errors and the APDU bytes of its I/O
+ * operations.
+ *
+ * <p>Recording costs two clock reads and a few relaxed atomic increments per operation, and
+ * {@link #getMetrics()} can be invoked from any thread without locking, so the decorator can stay
+ * enabled in production.
+ *
+ * <p>All the methods are forwarded to the decorated reader, including the optional ones, so that
+ * its native implementations are preserved. Only the ReaderSpi interface is decorated: the
+ * observation capabilities of the decorated reader are not exposed.
+ *
+ * @since 2.1.0
+ */
+class InstrumentedReaderSpi final : public ReaderSpi {
+public:
+    /**
+     * Invoked after each APDU exchange with its latency (for example to feed
+     * spi::ReaderAllocationPolicySpi::onLatencyMeasured). It must not throw.
+     *
+     * @since 2.1.0
+     */
+    using TransmitLatencyListener = std::function<void(const std::chrono::nanoseconds& latency)>;
+
+    /**
+     * @param readerSpi The reader to instrument.
+     * @param transmitLatencyListener The listener of the APDU exchange latencies (optional).
+     * @since 2.1.0
+     */
+    explicit InstrumentedReaderSpi(std::shared_ptr<ReaderSpi> readerSpi,
+                                   const TransmitLatencyListener& transmitLatencyListener =
+                                       TransmitLatencyListener())
+    : mReaderSpi(readerSpi),
+      mTransmitLatencyListener(transmitLatencyListener),
+      mBytesSent(0),
+      mBytesReceived(0)
+    {
+        for (int i = 0; i < ReaderMetrics::OPERATION_COUNT; i++) {
+            mErrorCounts[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Takes a snapshot of the recorded metrics.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const ReaderMetrics getMetrics() const
+    {
+        std::vector<ReaderMetrics::OperationMetrics> operationMetrics;
+        operationMetrics.reserve(ReaderMetrics::OPERATION_COUNT);
+
+        for (int i = 0; i < ReaderMetrics::OPERATION_COUNT; i++) {
+            operationMetrics.push_back(
+                ReaderMetrics::OperationMetrics(mLatencies[i].getCount(),
+                                                mErrorCounts[i].load(std::memory_order_relaxed),
+                                                mLatencies[i].getMean(),
+                                                mLatencies[i].getMax(),
+                                                mLatencies[i].getBucketCounts()));
+        }
+
+        return ReaderMetrics(operationMetrics,
+                             mBytesSent.load(std::memory_order_relaxed),
+                             mBytesReceived.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Gets the decorated reader.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> getReaderSpi() const
+    {
+        return mReaderSpi;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mReaderSpi->getName();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void openPhysicalChannel() override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::OPEN_PHYSICAL_CHANNEL);
+        mReaderSpi->openPhysicalChannel();
+        measure.succeed();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryOpenPhysicalChannel() noexcept override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::OPEN_PHYSICAL_CHANNEL);
+        const ReaderStatus status = mReaderSpi->tryOpenPhysicalChannel();
+        if (status.isOk()) {
+            measure.succeed();
+        }
+
+        return status;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void closePhysicalChannel() override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::CLOSE_PHYSICAL_CHANNEL);
+        mReaderSpi->closePhysicalChannel();
+        measure.succeed();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isPhysicalChannelOpen() const override
+    {
+        return mReaderSpi->isPhysicalChannelOpen();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool checkCardPresence() override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::CHECK_CARD_PRESENCE);
+        const bool isCardPresent = mReaderSpi->checkCardPresence();
+        measure.succeed();
+
+        return isCardPresent;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryCheckCardPresence(bool& isCardPresent) noexcept override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::CHECK_CARD_PRESENCE);
+        const ReaderStatus status = mReaderSpi->tryCheckCardPresence(isCardPresent);
+        if (status.isOk()) {
+            measure.succeed();
+        }
+
+        return status;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string getPowerOnData() const override
+    {
+        return mReaderSpi->getPowerOnData();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const PowerOnDataView getPowerOnDataView() const override
+    {
+        return mReaderSpi->getPowerOnDataView();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const ParsedPowerOnData> getParsedPowerOnData() const override
+    {
+        return mReaderSpi->getParsedPowerOnData();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::TRANSMIT_APDU);
+        const std::vector<uint8_t> apduOut = mReaderSpi->transmitApdu(apduIn);
+        measure.succeed(apduIn.size(), apduOut.size());
+
+        return apduOut;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t transmitApduInto(const uint8_t* apduIn,
+                                 const std::size_t apduInLength,
+                                 uint8_t* apduOut,
+                                 const std::size_t apduOutCapacity) override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::TRANSMIT_APDU);
+        const std::size_t apduOutLength =
+            mReaderSpi->transmitApduInto(apduIn, apduInLength, apduOut, apduOutCapacity);
+        measure.succeed(apduInLength, apduOutLength);
+
+        return apduOutLength;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryTransmitApdu(const uint8_t* apduIn,
+                                 const std::size_t apduInLength,
+                                 uint8_t* apduOut,
+                                 const std::size_t apduOutCapacity,
+                                 std::size_t& apduOutLength) noexcept override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::TRANSMIT_APDU);
+        const ReaderStatus status = mReaderSpi->tryTransmitApdu(
+            apduIn, apduInLength, apduOut, apduOutCapacity, apduOutLength);
+        if (status.isOk()) {
+            measure.succeed(apduInLength, apduOutLength);
+        }
+
+        return status;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::vector<std::vector<uint8_t>> transmitApdus(const std::vector<BatchedApdu>& apdus) override
+    {
+        Measure measure(*this, ReaderMetrics::Operation::TRANSMIT_APDUS);
+        const std::vector<std::vector<uint8_t>> apduOuts = mReaderSpi->transmitApdus(apdus);
+
+        std::size_t bytesSent = 0;
+        for (std::size_t i = 0; i < apduOuts.size(); i++) {
+            bytesSent += apdus[i].getApdu().size();
+        }
+        std::size_t bytesReceived = 0;
+        for (const auto& apduOut : apduOuts) {
+            bytesReceived += apduOut.size();
+        }
+        measure.succeed(bytesSent, bytesReceived);
+
+        return apduOuts;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    int transmitApduStreaming(const uint8_t cla,
+                              const uint8_t ins,
+                              const uint8_t p1,
+                              const uint8_t p2,
+                              const ApduChunkSource& commandData,
+                              const ApduChunkSink& responseData) override
+    {
+        std::size_t bytesSent = 4;
+        std::size_t bytesReceived = 2;
+
+        Measure measure(*this, ReaderMetrics::Operation::TRANSMIT_APDU_STREAMING);
+        const int statusWord = mReaderSpi->transmitApduStreaming(
+            cla, ins, p1, p2,
+            [&commandData, &bytesSent](uint8_t* buffer, std::size_t capacity) {
+                const std::size_t length = commandData(buffer, capacity);
+                bytesSent += length;
+                return length;
+            },
+            !responseData ? ApduChunkSink()
+                          : [&responseData, &bytesReceived](const uint8_t* data,
+                                                            std::size_t length) {
+                                bytesReceived += length;
+                                responseData(data, length);
+                            });
+        measure.succeed(bytesSent, bytesReceived);
+
+        return statusWord;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() override
+    {
+        return mReaderSpi->isContactless();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override
+    {
+        mReaderSpi->onUnregister();
+    }
+
+private:
+    /**
+     * Records the latency of an operation when going out of scope, as an error unless succeed()
+     * has been invoked.
+     */
+    class Measure final {
+    public:
+        Measure(InstrumentedReaderSpi& parent, const ReaderMetrics::Operation operation)
+        : mParent(parent),
+          mIndex(static_cast<std::size_t>(operation)),
+          mStart(std::chrono::steady_clock::now()),
+          mIsSuccessful(false) {}
+
+        void succeed(const std::size_t bytesSent = 0, const std::size_t bytesReceived = 0)
+        {
+            mIsSuccessful = true;
+            if (bytesSent != 0) {
+                mParent.mBytesSent.fetch_add(bytesSent, std::memory_order_relaxed);
+                mParent.mBytesReceived.fetch_add(bytesReceived, std::memory_order_relaxed);
+            }
+        }
+
+        ~Measure()
+        {
+            const std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - mStart;
+
+            mParent.mLatencies[mIndex].record(latency);
+            if (!mIsSuccessful) {
+                mParent.mErrorCounts[mIndex].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (mParent.mTransmitLatencyListener &&
+                mIndex == static_cast<std::size_t>(ReaderMetrics::Operation::TRANSMIT_APDU)) {
+                mParent.mTransmitLatencyListener(latency);
+            }
+        }
+
+    private:
+        InstrumentedReaderSpi& mParent;
+        const std::size_t mIndex;
+        const std::chrono::steady_clock::time_point mStart;
+        bool mIsSuccessful;
+    };
+
+    /**
+     *
+     */
+    const std::shared_ptr<ReaderSpi> mReaderSpi;
+
+    /**
+     *
+     */
+    const TransmitLatencyListener mTransmitLatencyListener;
+
+    /**
+     *
+     */
+    LatencyHistogram mLatencies[ReaderMetrics::OPERATION_COUNT];
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mErrorCounts[ReaderMetrics::OPERATION_COUNT];
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mBytesSent;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mBytesReceived;
+};
+
+}
+}
+}
+}
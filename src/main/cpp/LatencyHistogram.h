@@ -0,0 +1,183 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+/**
+ * Lock-free histogram of durations with power-of-two microsecond buckets.
+ *
+ * <p>Bucket 0 counts the durations shorter than 1 microsecond, bucket i those in [2^(i-1), 2^i)
+ * microseconds and the last bucket all the longer ones (same layout as
+ * spi::ReaderGroupStatistics).
+ *
+ * <p>Recording is wait-free; a snapshot taken while recording is in progress may be off by the
+ * concurrent records.
+ *
+ * @since 2.1.0
+ */
+class LatencyHistogram final {
+public:
+    /**
+     * The number of buckets (the last one is unbounded).
+     *
+     * @since 2.1.0
+     */
+    static const std::size_t BUCKET_COUNT = 24;
+
+    /**
+     *
+     */
+    LatencyHistogram()
+    : mCount(0), mTotalNanos(0), mMaxNanos(0)
+    {
+        for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+            mBuckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Records a duration.
+     *
+     * @param duration The duration to record.
+     * @since 2.1.0
+     */
+    void record(const std::chrono::nanoseconds& duration)
+    {
+        const uint64_t nanos = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+
+        mBuckets[getBucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+        mCount.fetch_add(1, std::memory_order_relaxed);
+        mTotalNanos.fetch_add(nanos, std::memory_order_relaxed);
+
+        uint64_t max = mMaxNanos.load(std::memory_order_relaxed);
+        while (nanos > max &&
+               !mMaxNanos.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * Gets the number of recorded durations.
+     *
+     * @since 2.1.0
+     */
+    uint64_t getCount() const
+    {
+        return mCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the sum of the recorded durations.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::nanoseconds getTotal() const
+    {
+        return std::chrono::nanoseconds(mTotalNanos.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Gets the mean of the recorded durations.
+     *
+     * @return Zero if nothing has been recorded.
+     * @since 2.1.0
+     */
+    std::chrono::nanoseconds getMean() const
+    {
+        const uint64_t count = getCount();
+
+        return count == 0 ? std::chrono::nanoseconds(0)
+                          : std::chrono::nanoseconds(
+                                mTotalNanos.load(std::memory_order_relaxed) / count);
+    }
+
+    /**
+     * Gets the longest recorded duration.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::nanoseconds getMax() const
+    {
+        return std::chrono::nanoseconds(mMaxNanos.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Gets the count of each bucket.
+     *
+     * @return A list of BUCKET_COUNT elements.
+     * @since 2.1.0
+     */
+    const std::vector<uint64_t> getBucketCounts() const
+    {
+        std::vector<uint64_t> bucketCounts(BUCKET_COUNT);
+        for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+            bucketCounts[i] = mBuckets[i].load(std::memory_order_relaxed);
+        }
+
+        return bucketCounts;
+    }
+
+    /**
+     * Gets the bucket of a duration.
+     *
+     * @param nanos The duration in nanoseconds.
+     * @return A bucket index.
+     * @since 2.1.0
+     */
+    static std::size_t getBucketIndex(const uint64_t nanos)
+    {
+        uint64_t micros = nanos / 1000;
+        std::size_t index = 0;
+
+        while (micros != 0 && index < BUCKET_COUNT - 1) {
+            micros >>= 1;
+            index++;
+        }
+
+        return index;
+    }
+
+private:
+    /**
+     *
+     */
+    std::atomic<uint64_t> mBuckets[BUCKET_COUNT];
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mTotalNanos;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mMaxNanos;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,107 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ReaderAllocationPolicySpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * Allocation policy choosing the free reader allocated the longest time ago (readers never
+ * allocated first), which spreads the load evenly over the group.
+ *
+ * @since 2.1.0
+ */
+class LeastRecentlyUsedAllocationPolicy final : public ReaderAllocationPolicySpi {
+public:
+    /**
+     *
+     */
+    LeastRecentlyUsedAllocationPolicy() : mSequence(0) {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                             const std::string& affinityKey) override
+    {
+        (void)affinityKey;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::size_t selectedIndex = 0;
+        uint64_t selectedSequence = UINT64_MAX;
+
+        for (std::size_t i = 0; i < freeReaders.size(); i++) {
+            const auto it = mLastAllocations.find(freeReaders[i]->getName());
+            const uint64_t sequence = it == mLastAllocations.end() ? 0 : it->second;
+            if (sequence < selectedSequence) {
+                selectedIndex = i;
+                selectedSequence = sequence;
+            }
+        }
+
+        return selectedIndex;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onReaderAllocated(const std::shared_ptr<ReaderSpi>& readerSpi,
+                           const std::string& affinityKey) override
+    {
+        (void)affinityKey;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mLastAllocations[readerSpi->getName()] = ++mSequence;
+    }
+
+private:
+    /**
+     *
+     */
+    uint64_t mSequence;
+
+    /**
+     * Sequence number of the last allocation of each reader, by name.
+     */
+    std::map<std::string, uint64_t> mLastAllocations;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,104 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ReaderAllocationPolicySpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * Allocation policy choosing the free reader with the lowest measured latency, based on the
+ * latencies reported through onLatencyMeasured.
+ *
+ * <p>Each reader latency is an exponential moving average (weight 1/8 for the new measure). Readers
+ * without measure yet are chosen first so that they get measured.
+ *
+ * @since 2.1.0
+ */
+class LowestLatencyAllocationPolicy final : public ReaderAllocationPolicySpi {
+public:
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                             const std::string& affinityKey) override
+    {
+        (void)affinityKey;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::size_t selectedIndex = 0;
+        int64_t selectedLatency = INT64_MAX;
+
+        for (std::size_t i = 0; i < freeReaders.size(); i++) {
+            const auto it = mLatencies.find(freeReaders[i]->getName());
+            const int64_t latency = it == mLatencies.end() ? 0 : it->second;
+            if (latency < selectedLatency) {
+                selectedIndex = i;
+                selectedLatency = latency;
+            }
+        }
+
+        return selectedIndex;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onLatencyMeasured(const std::shared_ptr<ReaderSpi>& readerSpi,
+                           const std::chrono::nanoseconds& latency) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto it = mLatencies.find(readerSpi->getName());
+        if (it == mLatencies.end()) {
+            mLatencies[readerSpi->getName()] = latency.count();
+        } else {
+            it->second += (latency.count() - it->second) / 8;
+        }
+    }
+
+private:
+    /**
+     * Average latency of each reader in nanoseconds, by name.
+     */
+    std::map<std::string, int64_t> mLatencies;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,152 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ParsedPowerOnData.h"
+#include "PowerOnDataView.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Reader-owned storage of the power-on data, from which a plugin implements
+ * ReaderSpi::getPowerOnData, ReaderSpi::getPowerOnDataView and ReaderSpi::getParsedPowerOnData.
+ *
+ * <p>The plugin invokes {@link #set(const uint8_t*, std::size_t)} when the physical channel is
+ * opened and {@link #clear()} when it is closed; each call starts a new generation. The hexadecimal
+ * representation and the decoded power-on data are computed once per generation.
+ *
+ * <p>Like the physical channel it follows, this class is not thread-safe.
+ *
+ * @since 2.1.0
+ */
+class PowerOnDataCache final {
+public:
+    /**
+     *
+     */
+    PowerOnDataCache()
+    : mParsedPowerOnData(
+          std::make_shared<const ParsedPowerOnData>(ParsedPowerOnData::parse(nullptr, 0))),
+      mGeneration(1) {}
+
+    /**
+     * Stores new power-on data (typically when the physical channel is opened).
+     *
+     * @param data The raw power-on data.
+     * @param size The number of bytes.
+     * @since 2.1.0
+     */
+    void set(const uint8_t* data, const std::size_t size)
+    {
+        static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+        mData.assign(data, data + size);
+
+        mHexString.resize(2 * size);
+        for (std::size_t i = 0; i < size; i++) {
+            mHexString[2 * i] = HEX_DIGITS[data[i] >> 4];
+            mHexString[2 * i + 1] = HEX_DIGITS[data[i] & 0x0F];
+        }
+
+        mParsedPowerOnData =
+            std::make_shared<const ParsedPowerOnData>(ParsedPowerOnData::parse(data, size));
+
+        mGeneration++;
+    }
+
+    /**
+     * Forgets the power-on data (typically when the physical channel is closed).
+     *
+     * <p>The storage is kept for the next generation.
+     *
+     * @since 2.1.0
+     */
+    void clear()
+    {
+        mData.clear();
+        mHexString.clear();
+        mParsedPowerOnData =
+            std::make_shared<const ParsedPowerOnData>(ParsedPowerOnData::parse(nullptr, 0));
+        mGeneration++;
+    }
+
+    /**
+     * Gets the power-on data as an hexadecimal string, as returned by ReaderSpi::getPowerOnData.
+     *
+     * @return An empty string if there is no power-on data.
+     * @since 2.1.0
+     */
+    const std::string& getHexString() const
+    {
+        return mHexString;
+    }
+
+    /**
+     * Gets a view of the power-on data, as returned by ReaderSpi::getPowerOnDataView.
+     *
+     * @return A valid view.
+     * @since 2.1.0
+     */
+    const PowerOnDataView getView() const
+    {
+        return PowerOnDataView(mData.data(), mData.size(), mGeneration);
+    }
+
+    /**
+     * Gets the decoded power-on data, as returned by ReaderSpi::getParsedPowerOnData.
+     *
+     * @return A not null reference, UNKNOWN format if there is no power-on data.
+     * @since 2.1.0
+     */
+    std::shared_ptr<const ParsedPowerOnData> getParsed() const
+    {
+        return mParsedPowerOnData;
+    }
+
+private:
+    /**
+     *
+     */
+    std::vector<uint8_t> mData;
+
+    /**
+     *
+     */
+    std::string mHexString;
+
+    /**
+     *
+     */
+    std::shared_ptr<const ParsedPowerOnData> mParsedPowerOnData;
+
+    /**
+     *
+     */
+    uint64_t mGeneration;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,119 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/* Plugin */
+#include "LatencyHistogram.h"
+#include "ReaderGroupStatistics.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * Lock-free counters of a reader group, producing the spi::ReaderGroupStatistics returned by
+ * spi::MonitoredPoolPluginSpi::getReaderGroupStatistics.
+ *
+ * <p>The pool plugin measures the wait and hold times itself and records them here; the reader
+ * counts, which the plugin already knows, are provided when taking the snapshot.
+ *
+ * @since 2.1.0
+ */
+class ReaderGroupStatisticsRecorder final {
+public:
+    /**
+     *
+     */
+    ReaderGroupStatisticsRecorder() : mAllocationFailureCount(0) {}
+
+    /**
+     * Records a successful allocation.
+     *
+     * @param waitTime The time spent waiting for the reader.
+     * @since 2.1.0
+     */
+    void recordAllocation(const std::chrono::nanoseconds& waitTime)
+    {
+        mAllocationWaitTimes.record(waitTime);
+    }
+
+    /**
+     * Records an allocation that failed or timed out.
+     *
+     * @since 2.1.0
+     */
+    void recordAllocationFailure()
+    {
+        mAllocationFailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Records the release of a reader.
+     *
+     * @param holdTime The time elapsed since the allocation of the reader.
+     * @since 2.1.0
+     */
+    void recordRelease(const std::chrono::nanoseconds& holdTime)
+    {
+        mHoldTimes.record(holdTime);
+    }
+
+    /**
+     * Takes a snapshot of the counters.
+     *
+     * @param totalReaderCount The number of readers of the group.
+     * @param freeReaderCount The number of readers currently free.
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const ReaderGroupStatistics getStatistics(const std::size_t totalReaderCount,
+                                              const std::size_t freeReaderCount) const
+    {
+        return ReaderGroupStatistics(
+                   totalReaderCount,
+                   freeReaderCount,
+                   mAllocationWaitTimes.getCount(),
+                   mAllocationFailureCount.load(std::memory_order_relaxed),
+                   mAllocationWaitTimes.getBucketCounts(),
+                   std::chrono::duration_cast<std::chrono::microseconds>(mHoldTimes.getMean()));
+    }
+
+private:
+    /**
+     *
+     */
+    LatencyHistogram mAllocationWaitTimes;
+
+    /**
+     *
+     */
+    LatencyHistogram mHoldTimes;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mAllocationFailureCount;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,213 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+/**
+ * Snapshot of the metrics recorded by an InstrumentedReaderSpi.
+ *
+ * @since 2.1.0
+ */
+class ReaderMetrics final {
+public:
+    /**
+     * Instrumented operations.
+     *
+     * @since 2.1.0
+     */
+    enum class Operation {
+        OPEN_PHYSICAL_CHANNEL,
+        CLOSE_PHYSICAL_CHANNEL,
+        CHECK_CARD_PRESENCE,
+        TRANSMIT_APDU,
+        TRANSMIT_APDUS,
+        TRANSMIT_APDU_STREAMING
+    };
+
+    /**
+     * Number of values of Operation.
+     *
+     * @since 2.1.0
+     */
+    enum : int {
+        OPERATION_COUNT = 6
+    };
+
+    /**
+     * Metrics of one operation.
+     *
+     * @since 2.1.0
+     */
+    class OperationMetrics final {
+    public:
+        /**
+         * @param count The number of invocations.
+         * @param errorCount The number of invocations that raised an exception.
+         * @param meanLatency The mean latency.
+         * @param maxLatency The maximum latency.
+         * @param latencyHistogram The latency bucket counts (see LatencyHistogram).
+         * @since 2.1.0
+         */
+        OperationMetrics(const uint64_t count,
+                         const uint64_t errorCount,
+                         const std::chrono::nanoseconds& meanLatency,
+                         const std::chrono::nanoseconds& maxLatency,
+                         const std::vector<uint64_t>& latencyHistogram)
+        : mCount(count),
+          mErrorCount(errorCount),
+          mMeanLatency(meanLatency),
+          mMaxLatency(maxLatency),
+          mLatencyHistogram(latencyHistogram) {}
+
+        /**
+         * @return The number of invocations.
+         * @since 2.1.0
+         */
+        uint64_t getCount() const
+        {
+            return mCount;
+        }
+
+        /**
+         * @return The number of invocations that raised an exception.
+         * @since 2.1.0
+         */
+        uint64_t getErrorCount() const
+        {
+            return mErrorCount;
+        }
+
+        /**
+         * @return The mean latency, zero if no invocation.
+         * @since 2.1.0
+         */
+        const std::chrono::nanoseconds& getMeanLatency() const
+        {
+            return mMeanLatency;
+        }
+
+        /**
+         * @return The maximum latency, zero if no invocation.
+         * @since 2.1.0
+         */
+        const std::chrono::nanoseconds& getMaxLatency() const
+        {
+            return mMaxLatency;
+        }
+
+        /**
+         * @return The latency bucket counts, with the layout of LatencyHistogram.
+         * @since 2.1.0
+         */
+        const std::vector<uint64_t>& getLatencyHistogram() const
+        {
+            return mLatencyHistogram;
+        }
+
+    private:
+        /**
+         *
+         */
+        uint64_t mCount;
+
+        /**
+         *
+         */
+        uint64_t mErrorCount;
+
+        /**
+         *
+         */
+        std::chrono::nanoseconds mMeanLatency;
+
+        /**
+         *
+         */
+        std::chrono::nanoseconds mMaxLatency;
+
+        /**
+         *
+         */
+        std::vector<uint64_t> mLatencyHistogram;
+    };
+
+    /**
+     * @param operationMetrics The metrics of each operation, in the order of Operation.
+     * @param bytesSent The number of APDU bytes sent to the card.
+     * @param bytesReceived The number of APDU bytes received from the card.
+     * @since 2.1.0
+     */
+    ReaderMetrics(const std::vector<OperationMetrics>& operationMetrics,
+                  const uint64_t bytesSent,
+                  const uint64_t bytesReceived)
+    : mOperationMetrics(operationMetrics), mBytesSent(bytesSent), mBytesReceived(bytesReceived) {}
+
+    /**
+     * Gets the metrics of an operation.
+     *
+     * @param operation The operation.
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const OperationMetrics& getOperationMetrics(const Operation operation) const
+    {
+        return mOperationMetrics[static_cast<std::size_t>(operation)];
+    }
+
+    /**
+     * @return The number of APDU bytes sent to the card.
+     * @since 2.1.0
+     */
+    uint64_t getBytesSent() const
+    {
+        return mBytesSent;
+    }
+
+    /**
+     * @return The number of APDU bytes received from the card.
+     * @since 2.1.0
+     */
+    uint64_t getBytesReceived() const
+    {
+        return mBytesReceived;
+    }
+
+private:
+    /**
+     *
+     */
+    std::vector<OperationMetrics> mOperationMetrics;
+
+    /**
+     *
+     */
+    uint64_t mBytesSent;
+
+    /**
+     *
+     */
+    uint64_t mBytesReceived;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,185 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+/**
+ * Bounded history of reader connections and disconnections, implementing the epoch contract of
+ * ObservablePluginSpi::getReaderNamesEpoch and ObservablePluginSpi::searchReaderNamesChanges.
+ *
+ * <p>The plugin records each change with {@link #onReaderConnected(const std::string&)} or
+ * {@link #onReaderDisconnected(const std::string&)} and forwards the two SPI methods to
+ * {@link #getEpoch()} and {@link #getChangesSince(uint64_t, std::vector<std::string>&,
+ * std::vector<std::string>&)}.
+ *
+ * <p>Reading the epoch is lock-free. All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class ReaderNamesJournal final {
+public:
+    /**
+     * @param maxHistorySize The maximum number of changes kept; changes since an older epoch are
+     *        reported as unknown.
+     * @since 2.1.0
+     */
+    explicit ReaderNamesJournal(const std::size_t maxHistorySize = 256)
+    : mMaxHistorySize(maxHistorySize), mEpoch(1) {}
+
+    /**
+     * Gets the current epoch.
+     *
+     * @return A positive number.
+     * @since 2.1.0
+     */
+    uint64_t getEpoch() const
+    {
+        return mEpoch.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Records the connection of a reader.
+     *
+     * @param readerName The name of the reader.
+     * @since 2.1.0
+     */
+    void onReaderConnected(const std::string& readerName)
+    {
+        record(readerName, true);
+    }
+
+    /**
+     * Records the disconnection of a reader.
+     *
+     * @param readerName The name of the reader.
+     * @since 2.1.0
+     */
+    void onReaderDisconnected(const std::string& readerName)
+    {
+        record(readerName, false);
+    }
+
+    /**
+     * Gets the net changes since the provided epoch.
+     *
+     * <p>A reader connected then disconnected after the epoch is not reported. A reader
+     * disconnected then connected again is reported in both lists.
+     *
+     * @param epoch A previously returned epoch.
+     * @param connectedReaderNames Filled with the names of the readers connected since the epoch.
+     * @param disconnectedReaderNames Filled with the names of the readers disconnected since the
+     *        epoch.
+     * @return False if the epoch is older than the kept history (or unknown), in which case the
+     *         lists are left untouched.
+     * @since 2.1.0
+     */
+    bool getChangesSince(const uint64_t epoch,
+                         std::vector<std::string>& connectedReaderNames,
+                         std::vector<std::string>& disconnectedReaderNames) const
+    {
+        if (epoch == getEpoch()) {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const uint64_t currentEpoch = mEpoch.load(std::memory_order_relaxed);
+        if (epoch == 0 ||
+            epoch > currentEpoch ||
+            currentEpoch - epoch > mHistory.size()) {
+            return false;
+        }
+
+        /* First and last change of each reader since the epoch */
+        std::map<std::string, std::pair<bool, bool>> changes;
+        for (auto it = mHistory.end() - static_cast<std::ptrdiff_t>(currentEpoch - epoch);
+             it != mHistory.end();
+             ++it) {
+            auto change = changes.find(it->first);
+            if (change == changes.end()) {
+                changes.insert(std::make_pair(it->first, std::make_pair(it->second, it->second)));
+            } else {
+                change->second.second = it->second;
+            }
+        }
+
+        for (const auto& change : changes) {
+            const bool isFirstConnection = change.second.first;
+            const bool isLastConnection = change.second.second;
+            if (!isFirstConnection) {
+                disconnectedReaderNames.push_back(change.first);
+            }
+            if (isLastConnection) {
+                connectedReaderNames.push_back(change.first);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     *
+     */
+    const std::size_t mMaxHistorySize;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mEpoch;
+
+    /**
+     * Reader name and connection flag of the latest changes, the last one matching the current
+     * epoch.
+     */
+    std::deque<std::pair<std::string, bool>> mHistory;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     *
+     */
+    void record(const std::string& readerName, const bool isConnection)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mHistory.push_back(std::make_pair(readerName, isConnection));
+        if (mHistory.size() > mMaxHistorySize) {
+            mHistory.pop_front();
+        }
+
+        mEpoch.fetch_add(1, std::memory_order_release);
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,180 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+
+/* Plugin */
+#include "MultiplexedObservationSpi.h"
+
+/* Util */
+#include "IllegalStateException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader::observable;
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Level-triggered waitable event backing MultiplexedObservationSpi::getReadinessHandle: an
+ * eventfd on Linux, a pipe on the other POSIX systems and a manual-reset event on Windows.
+ *
+ * <p>All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class ReadinessEvent final {
+public:
+    /**
+     * @throw IllegalStateException If the system resources cannot be allocated.
+     * @since 2.1.0
+     */
+    ReadinessEvent()
+    {
+#if defined(_WIN32)
+        mHandle = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        if (mHandle == nullptr) {
+            throw IllegalStateException("Unable to create the readiness event");
+        }
+#elif defined(__linux__)
+        mHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (mHandle < 0) {
+            throw IllegalStateException("Unable to create the readiness event");
+        }
+#else
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw IllegalStateException("Unable to create the readiness event");
+        }
+        for (const int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        mHandle = fds[0];
+        mWriteFd = fds[1];
+#endif
+    }
+
+    /**
+     *
+     */
+    ReadinessEvent(const ReadinessEvent&) = delete;
+
+    /**
+     *
+     */
+    ReadinessEvent& operator=(const ReadinessEvent&) = delete;
+
+    /**
+     *
+     */
+    ~ReadinessEvent()
+    {
+#if defined(_WIN32)
+        CloseHandle(mHandle);
+#elif defined(__linux__)
+        close(mHandle);
+#else
+        close(mHandle);
+        close(mWriteFd);
+#endif
+    }
+
+    /**
+     * Makes the handle ready.
+     *
+     * @since 2.1.0
+     */
+    void signal()
+    {
+#if defined(_WIN32)
+        SetEvent(mHandle);
+#elif defined(__linux__)
+        const uint64_t one = 1;
+        /* Cannot fail but on counter overflow, in which case the event is ready anyway */
+        const ssize_t written = write(mHandle, &one, sizeof(one));
+        (void)written;
+#else
+        const uint8_t one = 1;
+        /* Fails only if the pipe is full, in which case the event is ready anyway */
+        const ssize_t written = write(mWriteFd, &one, sizeof(one));
+        (void)written;
+#endif
+    }
+
+    /**
+     * Resets the handle.
+     *
+     * @since 2.1.0
+     */
+    void clear()
+    {
+#if defined(_WIN32)
+        ResetEvent(mHandle);
+#elif defined(__linux__)
+        uint64_t count;
+        const ssize_t length = ::read(mHandle, &count, sizeof(count));
+        (void)length;
+#else
+        uint8_t buffer[64];
+        while (::read(mHandle, buffer, sizeof(buffer)) > 0) {}
+#endif
+    }
+
+    /**
+     * Gets the waitable handle.
+     *
+     * @return A valid handle.
+     * @since 2.1.0
+     */
+    MultiplexedObservationSpi::ReadinessHandle getHandle() const
+    {
+        return mHandle;
+    }
+
+private:
+    /**
+     *
+     */
+    MultiplexedObservationSpi::ReadinessHandle mHandle;
+
+#if !defined(_WIN32) && !defined(__linux__)
+    /**
+     *
+     */
+    int mWriteFd;
+#endif
+};
+
+}
+}
+}
+}
@@ -0,0 +1,404 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#else
+#include <poll.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Plugin */
+#include "MultiplexedObservationSpi.h"
+#include "ReadinessEvent.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader::observable;
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Waits on the readiness handles of many readers (see MultiplexedObservationSpi) from a single
+ * thread, with epoll on Linux, poll on the other POSIX systems and WaitForMultipleObjects on
+ * Windows (limited to 63 handles).
+ *
+ * <p>A callback is registered for each handle; it is invoked by the waiting thread when the handle
+ * is ready and typically acknowledges the readiness, checks the card presence of the reader and
+ * notifies the observation state machine. Since handles are level-triggered, a callback that does
+ * not acknowledge the readiness is invoked again on the next wait.
+ *
+ * <p>Handles can be added and removed from any thread, including from a callback. Once
+ * {@link #remove()} has returned, the callback of the handle is no longer invoked, so that the
+ * resources it captures can be released.
+ *
+ * @since 2.1.0
+ */
+class ReadinessMultiplexer final {
+public:
+    /**
+     * Invoked when a handle is ready.
+     *
+     * @since 2.1.0
+     */
+    using ReadinessCallback = std::function<void()>;
+
+    /**
+     * @throw IllegalStateException If the system resources cannot be allocated.
+     * @since 2.1.0
+     */
+    ReadinessMultiplexer() : mIsStopped(false), mDispatchedHandle()
+    {
+#if defined(__linux__)
+        mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (mEpollFd < 0) {
+            throw IllegalStateException("Unable to create the epoll instance");
+        }
+
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = mWakeEvent.getHandle();
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeEvent.getHandle(), &event) != 0) {
+            close(mEpollFd);
+            throw IllegalStateException("Unable to register the wake-up event");
+        }
+#endif
+    }
+
+    /**
+     *
+     */
+    ReadinessMultiplexer(const ReadinessMultiplexer&) = delete;
+
+    /**
+     *
+     */
+    ReadinessMultiplexer& operator=(const ReadinessMultiplexer&) = delete;
+
+    /**
+     *
+     */
+    ~ReadinessMultiplexer()
+    {
+#if defined(__linux__)
+        close(mEpollFd);
+#endif
+    }
+
+    /**
+     * Starts waiting on a handle.
+     *
+     * @param handle The readiness handle.
+     * @param callback Invoked when the handle is ready.
+     * @throw IllegalArgumentException If the handle is already registered.
+     * @throw IllegalStateException If the handle cannot be registered.
+     * @since 2.1.0
+     */
+    void add(const MultiplexedObservationSpi::ReadinessHandle handle,
+             const ReadinessCallback& callback)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mCallbacks.find(handle) != mCallbacks.end()) {
+            throw IllegalArgumentException("Readiness handle already registered");
+        }
+
+#if defined(_WIN32)
+        if (mCallbacks.size() + 1 >= MAXIMUM_WAIT_OBJECTS) {
+            throw IllegalStateException("Too many readiness handles");
+        }
+#elif defined(__linux__)
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = handle;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, handle, &event) != 0) {
+            throw IllegalStateException("Unable to register the readiness handle");
+        }
+#endif
+
+        mCallbacks.insert(std::make_pair(handle, std::make_shared<ReadinessCallback>(callback)));
+
+        /* Makes a wait in progress take the new handle into account */
+        mWakeEvent.signal();
+    }
+
+    /**
+     * Stops waiting on a handle; its callback is not invoked anymore.
+     *
+     * <p>If the callback is being invoked by another thread, waits for the invocation to complete.
+     * An invocation in progress on the calling thread (i.e. removal from the callback itself) is
+     * not waited for.
+     *
+     * @param handle The readiness handle.
+     * @return False if the handle was not registered.
+     * @since 2.1.0
+     */
+    bool remove(const MultiplexedObservationSpi::ReadinessHandle handle)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        if (mCallbacks.erase(handle) == 0) {
+            return false;
+        }
+
+#if defined(__linux__)
+        epoll_ctl(mEpollFd, EPOLL_CTL_DEL, handle, nullptr);
+#endif
+
+        mWakeEvent.signal();
+
+        if (mDispatchingThread != std::this_thread::get_id()) {
+            mDispatchCompleted.wait(lock, [this, handle] {
+                return mDispatchingThread == std::thread::id() || mDispatchedHandle != handle;
+            });
+        }
+
+        return true;
+    }
+
+    /**
+     * Waits until at least one handle is ready, the timeout expires or {@link #stop()} is invoked,
+     * then invokes the callbacks of the ready handles.
+     *
+     * @param timeout The maximum waiting time, negative to wait indefinitely.
+     * @return The number of callbacks invoked.
+     * @throw IllegalStateException If the wait has failed.
+     * @since 2.1.0
+     */
+    std::size_t waitOnce(const std::chrono::milliseconds& timeout)
+    {
+        const std::vector<MultiplexedObservationSpi::ReadinessHandle> readyHandles =
+            waitForReadyHandles(timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+
+        std::size_t count = 0;
+        for (const auto& handle : readyHandles) {
+            std::shared_ptr<ReadinessCallback> callback;
+            {
+                /* The handle may have been removed by a previous callback or by another thread */
+                std::lock_guard<std::mutex> lock(mMutex);
+                const auto it = mCallbacks.find(handle);
+                if (it == mCallbacks.end()) {
+                    continue;
+                }
+                callback = it->second;
+                mDispatchedHandle = handle;
+                mDispatchingThread = std::this_thread::get_id();
+            }
+
+            try {
+                (*callback)();
+            } catch (...) {
+                endDispatch();
+                throw;
+            }
+            endDispatch();
+            count++;
+        }
+
+        return count;
+    }
+
+    /**
+     * Waits and invokes the callbacks of the ready handles until {@link #stop()} is invoked.
+     *
+     * @throw IllegalStateException If a wait has failed.
+     * @since 2.1.0
+     */
+    void run()
+    {
+        while (!mIsStopped.exchange(false)) {
+            waitOnce(std::chrono::milliseconds(-1));
+        }
+    }
+
+    /**
+     * Makes {@link #run()} return, or the next invocation of it if none is in progress.
+     *
+     * @since 2.1.0
+     */
+    void stop()
+    {
+        mIsStopped = true;
+        mWakeEvent.signal();
+    }
+
+private:
+    /**
+     *
+     */
+    std::map<MultiplexedObservationSpi::ReadinessHandle, std::shared_ptr<ReadinessCallback>>
+        mCallbacks;
+
+    /**
+     * Interrupts the wait when stopping or when the handles change.
+     */
+    ReadinessEvent mWakeEvent;
+
+    /**
+     *
+     */
+    std::atomic<bool> mIsStopped;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+
+    /**
+     * Thread invoking a callback, default-constructed when no callback is being invoked.
+     */
+    std::thread::id mDispatchingThread;
+
+    /**
+     * Handle whose callback is being invoked, meaningful while mDispatchingThread is set.
+     */
+    MultiplexedObservationSpi::ReadinessHandle mDispatchedHandle;
+
+    /**
+     * Notified each time a callback invocation completes.
+     */
+    std::condition_variable mDispatchCompleted;
+
+#if defined(__linux__)
+    /**
+     *
+     */
+    int mEpollFd;
+#endif
+
+    /**
+     *
+     */
+    void endDispatch()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mDispatchingThread = std::thread::id();
+        mDispatchCompleted.notify_all();
+    }
+
+    /**
+     * Gets the handles found ready, in no particular order.
+     */
+    std::vector<MultiplexedObservationSpi::ReadinessHandle> waitForReadyHandles(
+        const int timeoutMs)
+    {
+        std::vector<MultiplexedObservationSpi::ReadinessHandle> readyHandles;
+
+#if defined(_WIN32)
+        std::vector<HANDLE> handles(1, mWakeEvent.getHandle());
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const auto& callback : mCallbacks) {
+                handles.push_back(callback.first);
+            }
+        }
+
+        const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()),
+                                                    handles.data(),
+                                                    FALSE,
+                                                    timeoutMs < 0 ? INFINITE : timeoutMs);
+        if (result == WAIT_FAILED) {
+            throw IllegalStateException("Unable to wait for the readiness handles");
+        }
+        if (result == WAIT_TIMEOUT) {
+            return readyHandles;
+        }
+
+        /* Only the first ready handle is reported, the following ones are polled */
+        mWakeEvent.clear();
+        const std::size_t first = static_cast<std::size_t>(result - WAIT_OBJECT_0);
+        for (std::size_t i = first > 1 ? first : 1; i < handles.size(); i++) {
+            if (i == first || WaitForSingleObject(handles[i], 0) == WAIT_OBJECT_0) {
+                readyHandles.push_back(handles[i]);
+            }
+        }
+#elif defined(__linux__)
+        struct epoll_event events[64];
+        const int count = epoll_wait(mEpollFd, events, 64, timeoutMs);
+        if (count < 0 && errno != EINTR) {
+            throw IllegalStateException("Unable to wait for the readiness handles");
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.fd == mWakeEvent.getHandle()) {
+                mWakeEvent.clear();
+            } else {
+                readyHandles.push_back(events[i].data.fd);
+            }
+        }
+#else
+        std::vector<struct pollfd> fds(1);
+        fds[0].fd = mWakeEvent.getHandle();
+        fds[0].events = POLLIN;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const auto& callback : mCallbacks) {
+                struct pollfd fd = {};
+                fd.fd = callback.first;
+                fd.events = POLLIN;
+                fds.push_back(fd);
+            }
+        }
+
+        const int count = poll(fds.data(), static_cast<nfds_t>(fds.size()), timeoutMs);
+        if (count < 0 && errno != EINTR) {
+            throw IllegalStateException("Unable to wait for the readiness handles");
+        }
+
+        if (count > 0) {
+            if (fds[0].revents != 0) {
+                mWakeEvent.clear();
+            }
+            for (std::size_t i = 1; i < fds.size(); i++) {
+                if (fds[i].revents != 0) {
+                    readyHandles.push_back(fds[i].fd);
+                }
+            }
+        }
+#endif
+
+        return readyHandles;
+    }
+};
+
+}
+}
+}
+}
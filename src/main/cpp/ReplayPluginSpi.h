@@ -0,0 +1,99 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ApduTraceDecoder.h"
+#include "PluginSpi.h"
+#include "ReplayReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * {@link PluginSpi} exposing a ReplayReaderSpi for each recorded trace, to run the upper layers
+ * without hardware (for example on CI machines).
+ *
+ * @since 2.1.0
+ */
+class ReplayPluginSpi final : public PluginSpi {
+public:
+    /**
+     * @param name The name of the plugin.
+     * @param traces The recorded traces, one per reader.
+     * @param isContactless True if the replayed readers are contactless ones.
+     * @param isTimingEmulated True to reproduce the recorded duration of the APDU exchanges.
+     * @since 2.1.0
+     */
+    ReplayPluginSpi(const std::string& name,
+                    const std::vector<ApduTraceDecoder>& traces,
+                    const bool isContactless,
+                    const bool isTimingEmulated = false)
+    : mName(name)
+    {
+        for (const auto& trace : traces) {
+            mReaders.push_back(
+                std::make_shared<ReplayReaderSpi>(trace, isContactless, isTimingEmulated));
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mName;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ReaderSpi>> searchAvailableReaders() override
+    {
+        return mReaders;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override {}
+
+private:
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     *
+     */
+    std::vector<std::shared_ptr<ReaderSpi>> mReaders;
+};
+
+}
+}
+}
+}
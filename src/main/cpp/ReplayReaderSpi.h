@@ -0,0 +1,463 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Plugin */
+#include "ApduTraceDecoder.h"
+#include "CardIOException.h"
+#include "PowerOnDataCache.h"
+#include "ReaderIOException.h"
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * {@link ReaderSpi} serving the card sessions recorded by a TracingReaderSpi, without hardware.
+ *
+ * <p>Each kind of event is replayed in the recorded order, wrapping around at the end of the trace:
+ * <ul>
+ *   <li>an APDU command is answered with the response (or the error) recorded after the next
+ *       recorded command with the same bytes, a command never recorded raising a CardIOException,
+ *   <li>a streamed exchange is answered with the response chunks and the status word (or the
+ *       error) of the next recorded stream with the same header and command data, whatever the
+ *       chunk sizes, a stream never recorded raising a CardIOException,
+ *   <li>the power-on data of each opening of the physical channel is the one of the next recorded
+ *       opening,
+ *   <li>the card presence is the next recorded one (true if none was recorded).
+ * </ul>
+ *
+ * <p>Replay is deterministic and runs at full speed by default. When timing emulation is enabled,
+ * each APDU exchange lasts at least as long as the recorded one, which reproduces the latency
+ * profile of the recorded reader.
+ *
+ * <p>All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class ReplayReaderSpi final : public ReaderSpi {
+public:
+    /**
+     * @param trace The recorded trace.
+     * @param isContactless True if the replayed reader is a contactless one.
+     * @param isTimingEmulated True to reproduce the recorded duration of the APDU exchanges.
+     * @since 2.1.0
+     */
+    ReplayReaderSpi(const ApduTraceDecoder& trace,
+                    const bool isContactless,
+                    const bool isTimingEmulated = false)
+    : mName(trace.getReaderName()),
+      mRecords(trace.getRecords()),
+      mIsContactless(isContactless),
+      mIsTimingEmulated(isTimingEmulated),
+      mIsPhysicalChannelOpen(false),
+      mCommandCursor(0),
+      mChannelCursor(0),
+      mPresenceCursor(0) {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mName;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void openPhysicalChannel() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const std::size_t index = findNext(mChannelCursor, ApduTraceRecord::Type::CHANNEL_OPENED);
+        if (index != NOT_FOUND) {
+            const std::vector<uint8_t>& powerOnData = mRecords[index].getPayload();
+            mPowerOnData.set(powerOnData.data(), powerOnData.size());
+            mChannelCursor = index + 1;
+        } else {
+            mPowerOnData.set(nullptr, 0);
+        }
+
+        mIsPhysicalChannelOpen = true;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void closePhysicalChannel() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mPowerOnData.clear();
+        mIsPhysicalChannelOpen = false;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isPhysicalChannelOpen() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mIsPhysicalChannelOpen;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool checkCardPresence() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const std::size_t index = findNext(mPresenceCursor, ApduTraceRecord::Type::CARD_PRESENCE);
+        if (index == NOT_FOUND) {
+            return true;
+        }
+
+        mPresenceCursor = index + 1;
+
+        const std::vector<uint8_t>& payload = mRecords[index].getPayload();
+
+        return !payload.empty() && payload[0] != 0;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string getPowerOnData() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPowerOnData.getHexString();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const PowerOnDataView getPowerOnDataView() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPowerOnData.getView();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const ParsedPowerOnData> getParsedPowerOnData() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPowerOnData.getParsed();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw ReaderIOException If the recorded exchange failed with a reader error.
+     * @throw CardIOException If the command was not recorded, or if its recorded exchange failed
+     *        with any other error.
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        std::size_t index = NOT_FOUND;
+        for (std::size_t i = 0; i < mRecords.size(); i++) {
+            const std::size_t candidate = (mCommandCursor + i) % mRecords.size();
+            if (candidate + 1 < mRecords.size() &&
+                mRecords[candidate].getType() == ApduTraceRecord::Type::COMMAND &&
+                mRecords[candidate].getPayload() == apduIn) {
+                index = candidate;
+                break;
+            }
+        }
+
+        if (index == NOT_FOUND) {
+            throw CardIOException(0, "No recorded response to the APDU command");
+        }
+
+        const ApduTraceRecord& command = mRecords[index];
+        const ApduTraceRecord& response = mRecords[index + 1];
+        mCommandCursor = index + 2;
+        lock.unlock();
+
+        emulateTiming(start, command, response);
+
+        if (response.getType() == ApduTraceRecord::Type::RESPONSE) {
+            return response.getPayload();
+        }
+
+        throwRecordedError(response, "No recorded response to the APDU command");
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The command data is read entirely before the recorded stream is looked up.
+     *
+     * @throw ReaderIOException If the recorded exchange failed with a reader error.
+     * @throw CardIOException If the stream was not recorded, or if its recorded exchange failed
+     *        with any other error.
+     * @since 2.1.0
+     */
+    int transmitApduStreaming(const uint8_t cla,
+                              const uint8_t ins,
+                              const uint8_t p1,
+                              const uint8_t p2,
+                              const ApduChunkSource& commandData,
+                              const ApduChunkSink& responseData) override
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        const std::vector<uint8_t> header = {cla, ins, p1, p2};
+        std::vector<uint8_t> command;
+        uint8_t chunk[MAX_CHUNK_LENGTH];
+        for (std::size_t length; (length = commandData(chunk, sizeof(chunk))) != 0;) {
+            command.insert(command.end(), chunk, chunk + length);
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        std::size_t index = NOT_FOUND;
+        std::size_t end = NOT_FOUND;
+        for (std::size_t i = 0; i < mRecords.size() && index == NOT_FOUND; i++) {
+            const std::size_t candidate = (mCommandCursor + i) % mRecords.size();
+            if (mRecords[candidate].getType() == ApduTraceRecord::Type::STREAM_STARTED &&
+                mRecords[candidate].getPayload() == header) {
+                end = findStreamEnd(candidate, command);
+                if (end != NOT_FOUND) {
+                    index = candidate;
+                }
+            }
+        }
+
+        if (index == NOT_FOUND) {
+            throw CardIOException(0, "No recorded stream for the APDU command");
+        }
+
+        mCommandCursor = end + 1;
+        lock.unlock();
+
+        emulateTiming(start, mRecords[index], mRecords[end]);
+
+        for (std::size_t i = index + 1; i < end && responseData; i++) {
+            if (mRecords[i].getType() == ApduTraceRecord::Type::RESPONSE_CHUNK) {
+                responseData(mRecords[i].getPayload().data(), mRecords[i].getPayload().size());
+            }
+        }
+
+        const std::vector<uint8_t>& trailer = mRecords[end].getPayload();
+        if (mRecords[end].getType() == ApduTraceRecord::Type::STREAM_ENDED &&
+            trailer.size() == 2) {
+            return (trailer[0] << 8) | trailer[1];
+        }
+
+        throwRecordedError(mRecords[end], "No recorded stream for the APDU command");
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() override
+    {
+        return mIsContactless;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override {}
+
+private:
+    /**
+     *
+     */
+    enum : std::size_t {
+        NOT_FOUND = static_cast<std::size_t>(-1),
+        MAX_CHUNK_LENGTH = 255
+    };
+
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     *
+     */
+    const std::vector<ApduTraceRecord> mRecords;
+
+    /**
+     *
+     */
+    const bool mIsContactless;
+
+    /**
+     *
+     */
+    const bool mIsTimingEmulated;
+
+    /**
+     *
+     */
+    bool mIsPhysicalChannelOpen;
+
+    /**
+     *
+     */
+    PowerOnDataCache mPowerOnData;
+
+    /**
+     * Position from which the next command is searched.
+     */
+    std::size_t mCommandCursor;
+
+    /**
+     * Position from which the next channel opening is searched.
+     */
+    std::size_t mChannelCursor;
+
+    /**
+     * Position from which the next card presence is searched.
+     */
+    std::size_t mPresenceCursor;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     * Gets the position of the next record of the provided type, wrapping around at the end.
+     */
+    std::size_t findNext(const std::size_t cursor, const ApduTraceRecord::Type type) const
+    {
+        for (std::size_t i = 0; i < mRecords.size(); i++) {
+            const std::size_t index = (cursor + i) % mRecords.size();
+            if (mRecords[index].getType() == type) {
+                return index;
+            }
+        }
+
+        return NOT_FOUND;
+    }
+
+    /**
+     * Gets the position of the STREAM_ENDED or ERROR record ending the stream started at the
+     * provided position, provided that its command chunks make up the provided command data.
+     */
+    std::size_t findStreamEnd(const std::size_t start, const std::vector<uint8_t>& command) const
+    {
+        std::size_t offset = 0;
+        for (std::size_t i = start + 1; i < mRecords.size(); i++) {
+            const ApduTraceRecord& record = mRecords[i];
+            switch (record.getType()) {
+            case ApduTraceRecord::Type::COMMAND_CHUNK:
+                if (offset + record.getPayload().size() > command.size() ||
+                    !std::equal(record.getPayload().begin(),
+                                record.getPayload().end(),
+                                command.begin() + offset)) {
+                    return NOT_FOUND;
+                }
+                offset += record.getPayload().size();
+                break;
+            case ApduTraceRecord::Type::STREAM_ENDED:
+            case ApduTraceRecord::Type::ERROR:
+                return offset == command.size() ? i : NOT_FOUND;
+            case ApduTraceRecord::Type::STREAM_STARTED:
+                return NOT_FOUND;
+            default:
+                break;
+            }
+        }
+
+        return NOT_FOUND;
+    }
+
+    /**
+     * Makes the exchange started at the provided time last as long as the recorded one, if timing
+     * emulation is enabled.
+     */
+    void emulateTiming(const std::chrono::steady_clock::time_point& start,
+                       const ApduTraceRecord& first,
+                       const ApduTraceRecord& last) const
+    {
+        if (mIsTimingEmulated && last.getTimestamp() > first.getTimestamp()) {
+            std::this_thread::sleep_until(
+                start + std::chrono::microseconds(last.getTimestamp() - first.getTimestamp()));
+        }
+    }
+
+    /**
+     * Raises the recorded error, or a CardIOException with the provided message if the record is
+     * not a valid ERROR one.
+     */
+    [[noreturn]] void throwRecordedError(const ApduTraceRecord& record,
+                                         const StaticMessage& noResponseMessage) const
+    {
+        const std::vector<uint8_t>& payload = record.getPayload();
+        if (record.getType() != ApduTraceRecord::Type::ERROR || payload.empty()) {
+            throw CardIOException(0, noResponseMessage);
+        }
+
+        const std::string message(payload.begin() + 1, payload.end());
+        if (payload[0] == static_cast<uint8_t>(ApduTraceRecord::ErrorCategory::READER_IO)) {
+            throw ReaderIOException(message);
+        }
+        throw CardIOException(message);
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,65 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ReaderAllocationPolicySpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * Allocation policy cycling through the free readers, ignoring the affinity key.
+ *
+ * @since 2.1.0
+ */
+class RoundRobinAllocationPolicy final : public ReaderAllocationPolicySpi {
+public:
+    /**
+     *
+     */
+    RoundRobinAllocationPolicy() : mCounter(0) {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                             const std::string& affinityKey) override
+    {
+        (void)affinityKey;
+
+        return mCounter.fetch_add(1, std::memory_order_relaxed) % freeReaders.size();
+    }
+
+private:
+    /**
+     *
+     */
+    std::atomic<std::size_t> mCounter;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,150 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Plugin */
+#include "LeastRecentlyUsedAllocationPolicy.h"
+#include "ReaderAllocationPolicySpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * Allocation policy preferring the reader that last served the same affinity key (for example the
+ * same card or client), when it is free.
+ *
+ * <p>Otherwise, and when no affinity key is provided, the choice is delegated to a fallback policy
+ * (least recently used by default).
+ *
+ * <p>At most maxAffinityKeys keys are remembered; beyond that, an arbitrary entry is forgotten for
+ * each new key.
+ *
+ * @since 2.1.0
+ */
+class StickyAffinityAllocationPolicy final : public ReaderAllocationPolicySpi {
+public:
+    /**
+     * @param maxAffinityKeys The maximum number of affinity keys remembered.
+     * @param fallbackPolicy The policy used when the preferred reader is not available.
+     * @since 2.1.0
+     */
+    explicit StickyAffinityAllocationPolicy(
+        const std::size_t maxAffinityKeys = 4096,
+        std::shared_ptr<ReaderAllocationPolicySpi> fallbackPolicy =
+            std::make_shared<LeastRecentlyUsedAllocationPolicy>())
+    : mMaxAffinityKeys(maxAffinityKeys), mFallbackPolicy(fallbackPolicy) {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                             const std::string& affinityKey) override
+    {
+        if (!affinityKey.empty()) {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            const auto it = mAffinities.find(affinityKey);
+            if (it != mAffinities.end()) {
+                for (std::size_t i = 0; i < freeReaders.size(); i++) {
+                    if (freeReaders[i]->getName() == it->second) {
+                        return i;
+                    }
+                }
+            }
+        }
+
+        return mFallbackPolicy->selectReader(freeReaders, affinityKey);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onReaderAllocated(const std::shared_ptr<ReaderSpi>& readerSpi,
+                           const std::string& affinityKey) override
+    {
+        if (!affinityKey.empty()) {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            if (mAffinities.size() >= mMaxAffinityKeys &&
+                mAffinities.find(affinityKey) == mAffinities.end()) {
+                mAffinities.erase(mAffinities.begin());
+            }
+
+            mAffinities[affinityKey] = readerSpi->getName();
+        }
+
+        mFallbackPolicy->onReaderAllocated(readerSpi, affinityKey);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onReaderReleased(const std::shared_ptr<ReaderSpi>& readerSpi) override
+    {
+        mFallbackPolicy->onReaderReleased(readerSpi);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onLatencyMeasured(const std::shared_ptr<ReaderSpi>& readerSpi,
+                           const std::chrono::nanoseconds& latency) override
+    {
+        mFallbackPolicy->onLatencyMeasured(readerSpi, latency);
+    }
+
+private:
+    /**
+     *
+     */
+    const std::size_t mMaxAffinityKeys;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ReaderAllocationPolicySpi> mFallbackPolicy;
+
+    /**
+     * Name of the reader that last served each affinity key.
+     */
+    std::unordered_map<std::string, std::string> mAffinities;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,482 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ApduTraceBuffer.h"
+#include "CardIOException.h"
+#include "ReaderIOException.h"
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Decorator of a {@link ReaderSpi} recording its card sessions (channel events, card presence,
+ * APDU commands and responses, errors) into an ApduTraceBuffer.
+ *
+ * <p>Recording copies the exchanged bytes into the preallocated ring buffer without allocating, so
+ * the decorator can stay enabled in production and the buffer be flushed on demand, for example
+ * when a transaction fails. Traces can be read back with ApduTraceDecoder.
+ *
+ * <p>All the methods are forwarded to the decorated reader, including the optional ones, so that
+ * its native implementations are preserved, except transmitApdus: a batch is run command by
+ * command so that the commands sent before a failure are recorded. A streamed exchange is
+ * recorded chunk by chunk.
+ *
+ * @since 2.1.0
+ */
+class TracingReaderSpi final : public ReaderSpi {
+public:
+    /**
+     * @param readerSpi The reader to trace.
+     * @param traceBuffer The buffer receiving the records.
+     * @since 2.1.0
+     */
+    TracingReaderSpi(std::shared_ptr<ReaderSpi> readerSpi,
+                     std::shared_ptr<ApduTraceBuffer> traceBuffer)
+    : mReaderSpi(readerSpi), mTraceBuffer(traceBuffer) {}
+
+    /**
+     * Gets the buffer receiving the records.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ApduTraceBuffer> getTraceBuffer() const
+    {
+        return mTraceBuffer;
+    }
+
+    /**
+     * Gets the decorated reader.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> getReaderSpi() const
+    {
+        return mReaderSpi;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mReaderSpi->getName();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void openPhysicalChannel() override
+    {
+        try {
+            mReaderSpi->openPhysicalChannel();
+        } catch (const std::exception& e) {
+            recordError(e);
+            throw;
+        }
+
+        recordChannelOpened();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryOpenPhysicalChannel() noexcept override
+    {
+        const ReaderStatus status = mReaderSpi->tryOpenPhysicalChannel();
+        if (!status.isOk()) {
+            recordError(status);
+            return status;
+        }
+
+        try {
+            recordChannelOpened();
+        } catch (...) {
+            /* Tracing the power-on data is best effort */
+        }
+
+        return status;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void closePhysicalChannel() override
+    {
+        try {
+            mReaderSpi->closePhysicalChannel();
+        } catch (const std::exception& e) {
+            recordError(e);
+            throw;
+        }
+
+        mTraceBuffer->record(ApduTraceRecord::Type::CHANNEL_CLOSED);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isPhysicalChannelOpen() const override
+    {
+        return mReaderSpi->isPhysicalChannelOpen();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool checkCardPresence() override
+    {
+        bool isCardPresent;
+        try {
+            isCardPresent = mReaderSpi->checkCardPresence();
+        } catch (const std::exception& e) {
+            recordError(e);
+            throw;
+        }
+
+        const uint8_t payload = isCardPresent ? 1 : 0;
+        mTraceBuffer->record(ApduTraceRecord::Type::CARD_PRESENCE, &payload, 1);
+
+        return isCardPresent;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryCheckCardPresence(bool& isCardPresent) noexcept override
+    {
+        const ReaderStatus status = mReaderSpi->tryCheckCardPresence(isCardPresent);
+        if (!status.isOk()) {
+            recordError(status);
+            return status;
+        }
+
+        const uint8_t payload = isCardPresent ? 1 : 0;
+        recordSafely(ApduTraceRecord::Type::CARD_PRESENCE, &payload, 1);
+
+        return status;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string getPowerOnData() const override
+    {
+        return mReaderSpi->getPowerOnData();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const PowerOnDataView getPowerOnDataView() const override
+    {
+        return mReaderSpi->getPowerOnDataView();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const ParsedPowerOnData> getParsedPowerOnData() const override
+    {
+        return mReaderSpi->getParsedPowerOnData();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override
+    {
+        mTraceBuffer->record(ApduTraceRecord::Type::COMMAND, apduIn.data(), apduIn.size());
+
+        std::vector<uint8_t> apduOut;
+        try {
+            apduOut = mReaderSpi->transmitApdu(apduIn);
+        } catch (const std::exception& e) {
+            recordError(e);
+            throw;
+        }
+
+        mTraceBuffer->record(ApduTraceRecord::Type::RESPONSE, apduOut.data(), apduOut.size());
+
+        return apduOut;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::size_t transmitApduInto(const uint8_t* apduIn,
+                                 const std::size_t apduInLength,
+                                 uint8_t* apduOut,
+                                 const std::size_t apduOutCapacity) override
+    {
+        mTraceBuffer->record(ApduTraceRecord::Type::COMMAND, apduIn, apduInLength);
+
+        std::size_t apduOutLength;
+        try {
+            apduOutLength =
+                mReaderSpi->transmitApduInto(apduIn, apduInLength, apduOut, apduOutCapacity);
+        } catch (const std::exception& e) {
+            recordError(e);
+            throw;
+        }
+
+        mTraceBuffer->record(ApduTraceRecord::Type::RESPONSE, apduOut, apduOutLength);
+
+        return apduOutLength;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryTransmitApdu(const uint8_t* apduIn,
+                                 const std::size_t apduInLength,
+                                 uint8_t* apduOut,
+                                 const std::size_t apduOutCapacity,
+                                 std::size_t& apduOutLength) noexcept override
+    {
+        recordSafely(ApduTraceRecord::Type::COMMAND, apduIn, apduInLength);
+
+        const ReaderStatus status = mReaderSpi->tryTransmitApdu(
+            apduIn, apduInLength, apduOut, apduOutCapacity, apduOutLength);
+        if (!status.isOk()) {
+            recordError(status);
+            return status;
+        }
+
+        recordSafely(ApduTraceRecord::Type::RESPONSE, apduOut, apduOutLength);
+
+        return status;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The batch is transmitted with the default implementation, i.e. with {@link
+     * #transmitApdu(const std::vector<uint8_t>&)} for each command, so that each command is
+     * recorded before being sent and a failing batch leaves the commands and responses exchanged
+     * before the ERROR in the trace. The native batch implementation of the decorated reader is
+     * therefore not used while tracing.
+     *
+     * @since 2.1.0
+     */
+    std::vector<std::vector<uint8_t>> transmitApdus(const std::vector<BatchedApdu>& apdus) override
+    {
+        return ReaderSpi::transmitApdus(apdus);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The exchange is recorded as it goes: STREAM_STARTED with the header, then each command
+     * and response data chunk, then STREAM_ENDED with the status word (or ERROR).
+     *
+     * @since 2.1.0
+     */
+    int transmitApduStreaming(const uint8_t cla,
+                              const uint8_t ins,
+                              const uint8_t p1,
+                              const uint8_t p2,
+                              const ApduChunkSource& commandData,
+                              const ApduChunkSink& responseData) override
+    {
+        const uint8_t header[] = {cla, ins, p1, p2};
+        mTraceBuffer->record(ApduTraceRecord::Type::STREAM_STARTED, header, sizeof(header));
+
+        int statusWord;
+        try {
+            statusWord = mReaderSpi->transmitApduStreaming(
+                cla, ins, p1, p2,
+                [this, &commandData](uint8_t* buffer, std::size_t capacity) {
+                    const std::size_t length = commandData(buffer, capacity);
+                    if (length != 0) {
+                        mTraceBuffer->record(ApduTraceRecord::Type::COMMAND_CHUNK, buffer, length);
+                    }
+                    return length;
+                },
+                !responseData ? ApduChunkSink()
+                              : [this, &responseData](const uint8_t* data, std::size_t length) {
+                                    mTraceBuffer->record(
+                                        ApduTraceRecord::Type::RESPONSE_CHUNK, data, length);
+                                    responseData(data, length);
+                                });
+        } catch (const std::exception& e) {
+            recordError(e);
+            throw;
+        }
+
+        const uint8_t trailer[] = {static_cast<uint8_t>(statusWord >> 8),
+                                   static_cast<uint8_t>(statusWord)};
+        mTraceBuffer->record(ApduTraceRecord::Type::STREAM_ENDED, trailer, sizeof(trailer));
+
+        return statusWord;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() override
+    {
+        return mReaderSpi->isContactless();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override
+    {
+        mReaderSpi->onUnregister();
+    }
+
+private:
+    /**
+     *
+     */
+    enum : std::size_t {
+        MAX_REASON_LENGTH = 255
+    };
+
+    /**
+     *
+     */
+    const std::shared_ptr<ReaderSpi> mReaderSpi;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ApduTraceBuffer> mTraceBuffer;
+
+    /**
+     *
+     */
+    void recordError(const std::exception& e)
+    {
+        ApduTraceRecord::ErrorCategory category = ApduTraceRecord::ErrorCategory::OTHER;
+        if (dynamic_cast<const CardIOException*>(&e) != nullptr) {
+            category = ApduTraceRecord::ErrorCategory::CARD_IO;
+        } else if (dynamic_cast<const ReaderIOException*>(&e) != nullptr) {
+            category = ApduTraceRecord::ErrorCategory::READER_IO;
+        }
+
+        std::string payload(1, static_cast<char>(category));
+        payload += e.what();
+        mTraceBuffer->record(ApduTraceRecord::Type::ERROR,
+                             reinterpret_cast<const uint8_t*>(payload.data()),
+                             payload.size());
+    }
+
+    /**
+     * The reason is truncated to MAX_REASON_LENGTH bytes, not to allocate.
+     */
+    void recordError(const ReaderStatus& status) noexcept
+    {
+        ApduTraceRecord::ErrorCategory category = ApduTraceRecord::ErrorCategory::OTHER;
+        if (status.getCode() == ReaderStatus::Code::CARD_IO_ERROR) {
+            category = ApduTraceRecord::ErrorCategory::CARD_IO;
+        } else if (status.getCode() == ReaderStatus::Code::READER_IO_ERROR) {
+            category = ApduTraceRecord::ErrorCategory::READER_IO;
+        }
+
+        uint8_t payload[1 + MAX_REASON_LENGTH];
+        const std::size_t reasonLength =
+            std::min<std::size_t>(std::strlen(status.getReason()), MAX_REASON_LENGTH);
+        payload[0] = static_cast<uint8_t>(category);
+        std::memcpy(payload + 1, status.getReason(), reasonLength);
+
+        recordSafely(ApduTraceRecord::Type::ERROR, payload, 1 + reasonLength);
+    }
+
+    /**
+     * Records an event from an exception-free method: a failure of the trace buffer (a mutex
+     * error) must not terminate the process.
+     */
+    void recordSafely(const ApduTraceRecord::Type type,
+                      const uint8_t* payload,
+                      const std::size_t payloadLength) noexcept
+    {
+        try {
+            mTraceBuffer->record(type, payload, payloadLength);
+        } catch (...) {
+            /* Tracing is best effort */
+        }
+    }
+
+    /**
+     *
+     */
+    void recordChannelOpened()
+    {
+        const PowerOnDataView view = mReaderSpi->getPowerOnDataView();
+        if (view.isValid()) {
+            mTraceBuffer->record(ApduTraceRecord::Type::CHANNEL_OPENED,
+                                 view.getData(),
+                                 view.getSize());
+        } else {
+            std::vector<uint8_t> powerOnData;
+            ParsedPowerOnData::decodeHex(mReaderSpi->getPowerOnData(), powerOnData);
+            mTraceBuffer->record(ApduTraceRecord::Type::CHANNEL_OPENED,
+                                 powerOnData.data(),
+                                 powerOnData.size());
+        }
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,251 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ObservablePluginSpi.h"
+#include "ReaderNamesJournal.h"
+#include "VirtualReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin::spi;
+
+/**
+ * In-memory observable plugin of VirtualReaderSpi, into which the test scripts the connection and
+ * disconnection of readers.
+ *
+ * <p>The changes of the readers list are tracked with a ReaderNamesJournal, so that the Keyple Core
+ * adapter can monitor large numbers of readers without enumerating them.
+ *
+ * <p>All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class VirtualObservablePluginSpi final : public ObservablePluginSpi {
+public:
+    /**
+     * Creates the plugin with readerCount readers named "<name>-<index>", index starting from 0.
+     *
+     * @param name The name of the plugin.
+     * @param readerCount The number of readers initially connected.
+     * @param isContactless True if the readers are contactless ones.
+     * @param monitoringCycleDuration The monitoring cycle duration in milliseconds.
+     * @since 2.1.0
+     */
+    VirtualObservablePluginSpi(const std::string& name,
+                               const std::size_t readerCount,
+                               const bool isContactless,
+                               const int monitoringCycleDuration = 100)
+    : mName(name), mMonitoringCycleDuration(monitoringCycleDuration)
+    {
+        for (std::size_t i = 0; i < readerCount; i++) {
+            connectReader(name + "-" + std::to_string(i), isContactless);
+        }
+    }
+
+    /**
+     * Connects a new reader, replacing the one with the same name if any.
+     *
+     * @param readerName The name of the reader.
+     * @param isContactless True if the reader is a contactless one.
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    std::shared_ptr<VirtualReaderSpi> connectReader(const std::string& readerName,
+                                                    const bool isContactless)
+    {
+        auto reader = std::make_shared<VirtualReaderSpi>(readerName, isContactless);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mReaders.erase(readerName) != 0) {
+            mJournal.onReaderDisconnected(readerName);
+        }
+        mReaders.insert(std::make_pair(readerName, reader));
+        mJournal.onReaderConnected(readerName);
+
+        return reader;
+    }
+
+    /**
+     * Disconnects a reader.
+     *
+     * @param readerName The name of the reader.
+     * @return False if the reader was not connected.
+     * @since 2.1.0
+     */
+    bool disconnectReader(const std::string& readerName)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mReaders.erase(readerName) == 0) {
+            return false;
+        }
+        mJournal.onReaderDisconnected(readerName);
+
+        return true;
+    }
+
+    /**
+     * Gets a connected reader.
+     *
+     * @param readerName The name of the reader.
+     * @return Null if the reader is not connected.
+     * @since 2.1.0
+     */
+    std::shared_ptr<VirtualReaderSpi> getReader(const std::string& readerName) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto it = mReaders.find(readerName);
+
+        return it != mReaders.end() ? it->second : nullptr;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mName;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ReaderSpi>> searchAvailableReaders() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::vector<std::shared_ptr<ReaderSpi>> readers;
+        readers.reserve(mReaders.size());
+        for (const auto& reader : mReaders) {
+            readers.push_back(reader.second);
+        }
+
+        return readers;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    int getMonitoringCycleDuration() const override
+    {
+        return mMonitoringCycleDuration;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::string> searchAvailableReaderNames() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::vector<std::string> readerNames;
+        readerNames.reserve(mReaders.size());
+        for (const auto& reader : mReaders) {
+            readerNames.push_back(reader.first);
+        }
+
+        return readerNames;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    uint64_t getReaderNamesEpoch() const override
+    {
+        return mJournal.getEpoch();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool searchReaderNamesChanges(const uint64_t epoch,
+                                  std::vector<std::string>& connectedReaderNames,
+                                  std::vector<std::string>& disconnectedReaderNames) override
+    {
+        return mJournal.getChangesSince(epoch, connectedReaderNames, disconnectedReaderNames);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> searchReader(const std::string& readerName) override
+    {
+        return getReader(readerName);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override {}
+
+private:
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     *
+     */
+    const int mMonitoringCycleDuration;
+
+    /**
+     *
+     */
+    std::map<std::string, std::shared_ptr<VirtualReaderSpi>> mReaders;
+
+    /**
+     *
+     */
+    ReaderNamesJournal mJournal;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,205 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "PluginIOException.h"
+#include "PoolPluginSpi.h"
+#include "VirtualReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi;
+
+/**
+ * In-memory pool plugin of VirtualReaderSpi, organized in reader groups.
+ *
+ * <p>All methods are thread-safe.
+ *
+ * @since 2.1.0
+ */
+class VirtualPoolPluginSpi final : public PoolPluginSpi {
+public:
+    /**
+     * Creates the plugin with, for each group, the provided number of readers named
+     * "<group>-<index>", index starting from 0.
+     *
+     * @param name The name of the plugin.
+     * @param readerCounts The number of readers of each group.
+     * @param isContactless True if the readers are contactless ones.
+     * @since 2.1.0
+     */
+    VirtualPoolPluginSpi(const std::string& name,
+                         const std::map<std::string, std::size_t>& readerCounts,
+                         const bool isContactless)
+    : mName(name)
+    {
+        for (const auto& readerCount : readerCounts) {
+            Group& group = mGroups[readerCount.first];
+            for (std::size_t i = 0; i < readerCount.second; i++) {
+                auto reader = std::make_shared<VirtualReaderSpi>(
+                                  readerCount.first + "-" + std::to_string(i), isContactless);
+                group.mReaders.push_back(reader);
+                group.mFreeReaders.push_back(reader);
+                mReaderGroups.insert(std::make_pair(reader.get(), readerCount.first));
+            }
+        }
+    }
+
+    /**
+     * Gets all the readers of a group, allocated or not (for example to script card insertions).
+     *
+     * @param readerGroupReference The reader group reference.
+     * @return An empty list if the group is unknown.
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<VirtualReaderSpi>> getReaders(
+        const std::string& readerGroupReference) const
+    {
+        const auto it = mGroups.find(readerGroupReference);
+
+        return it != mGroups.end() ? it->second.mReaders :
+                                     std::vector<std::shared_ptr<VirtualReaderSpi>>();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mName;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::string> getReaderGroupReferences() const override
+    {
+        std::vector<std::string> readerGroupReferences;
+        readerGroupReferences.reserve(mGroups.size());
+        for (const auto& group : mGroups) {
+            readerGroupReferences.push_back(group.first);
+        }
+
+        return readerGroupReferences;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>An empty group reference allocates a reader of any group.
+     *
+     * @throw PluginIOException If the group is unknown or has no free reader.
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> allocateReader(const std::string& readerGroupReference) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        for (auto& group : mGroups) {
+            if ((readerGroupReference.empty() || group.first == readerGroupReference) &&
+                !group.second.mFreeReaders.empty()) {
+                std::shared_ptr<ReaderSpi> reader = group.second.mFreeReaders.back();
+                group.second.mFreeReaders.pop_back();
+
+                return reader;
+            }
+        }
+
+        throw PluginIOException("No reader available in group '" + readerGroupReference + "'");
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw PluginIOException If the reader does not belong to the pool.
+     * @since 2.1.0
+     */
+    void releaseReader(std::shared_ptr<ReaderSpi> readerSpi) override
+    {
+        const auto it = mReaderGroups.find(readerSpi.get());
+        if (it == mReaderGroups.end()) {
+            throw PluginIOException("The reader does not belong to the pool");
+        }
+
+        Group& group = mGroups.find(it->second)->second;
+        for (const auto& reader : group.mReaders) {
+            if (reader == readerSpi) {
+                std::lock_guard<std::mutex> lock(mMutex);
+
+                /* Releasing a free reader has no effect */
+                if (std::find(group.mFreeReaders.begin(), group.mFreeReaders.end(), reader) ==
+                    group.mFreeReaders.end()) {
+                    group.mFreeReaders.push_back(reader);
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override {}
+
+private:
+    /**
+     *
+     */
+    struct Group {
+        std::vector<std::shared_ptr<VirtualReaderSpi>> mReaders;
+        std::vector<std::shared_ptr<VirtualReaderSpi>> mFreeReaders;
+    };
+
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     * Groups by reference; the map itself is immutable after construction.
+     */
+    std::map<std::string, Group> mGroups;
+
+    /**
+     * Group reference of each reader; immutable after construction.
+     */
+    std::map<const ReaderSpi*, std::string> mReaderGroups;
+
+    /**
+     * Protects the free readers lists.
+     */
+    std::mutex mMutex;
+};
+
+}
+}
+}
+}
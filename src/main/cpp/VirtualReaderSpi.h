@@ -0,0 +1,725 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Plugin */
+#include "CardIOException.h"
+#include "DontWaitForCardRemovalDuringProcessingSpi.h"
+#include "MultiplexedObservationSpi.h"
+#include "ObservableReaderSpi.h"
+#include "PowerOnDataCache.h"
+#include "ReadinessEvent.h"
+#include "ReaderIOException.h"
+#include "TaskCanceledException.h"
+#include "WaitForCardInsertionBlockingSpi.h"
+#include "WaitForCardRemovalBlockingSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace cpp {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi::reader;
+using namespace keyple::core::plugin::spi::reader::observable;
+using namespace keyple::core::plugin::spi::reader::observable::state::insertion;
+using namespace keyple::core::plugin::spi::reader::observable::state::processing;
+using namespace keyple::core::plugin::spi::reader::observable::state::removal;
+
+/**
+ * In-memory observable reader, into which the test scripts the insertion and removal of simulated
+ * cards.
+ *
+ * <p>A simulated card is made of its power-on data and of an {@link ApduResponder} computing the
+ * response to each APDU command. Insertions and removals are also signaled through the
+ * MultiplexedObservationSpi readiness handle. A latency can be added to each card operation and
+ * errors can be injected at a given rate, drawn from a seeded generator so that runs are
+ * reproducible.
+ *
+ * <p>The deadline-aware waits return as soon as the wait is stopped, well within
+ * MAX_STOP_LATENCY_MILLIS. A stop request is never lost: it cancels the current wait of its kind
+ * (insertion or removal) or, if none is in progress, the next one.
+ *
+ * <p>All methods are thread-safe; the responder is invoked without holding any lock and must
+ * therefore be thread-safe if the reader is shared between threads.
+ *
+ * @since 2.1.0
+ */
+class VirtualReaderSpi final
+: public ObservableReaderSpi,
+  public WaitForCardInsertionBlockingSpi,
+  public DontWaitForCardRemovalDuringProcessingSpi,
+  public WaitForCardRemovalBlockingSpi,
+  public MultiplexedObservationSpi {
+public:
+    /**
+     * Computes the response of the simulated card to an APDU command.
+     *
+     * <p>It may throw a CardIOException to simulate a communication failure.
+     *
+     * @since 2.1.0
+     */
+    using ApduResponder =
+        std::function<const std::vector<uint8_t>(const std::vector<uint8_t>& apduIn)>;
+
+    /**
+     * @param name The name of the reader.
+     * @param isContactless True if the reader is a contactless one.
+     * @since 2.1.0
+     */
+    VirtualReaderSpi(const std::string& name, const bool isContactless)
+    : mName(name),
+      mIsContactless(isContactless),
+      mIsCardPresent(false),
+      mIsPhysicalChannelOpen(false),
+      mInsertionStop(),
+      mRemovalStop(),
+      mLatency(0),
+      mErrorRate(0),
+      mTransmittedApduCount(0) {}
+
+    /**
+     * Inserts a simulated card, replacing the current one if any.
+     *
+     * @param powerOnData The raw power-on data of the card.
+     * @param responder The responder of the card.
+     * @since 2.1.0
+     */
+    void insertCard(const std::vector<uint8_t>& powerOnData, const ApduResponder& responder)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mCardPowerOnData = powerOnData;
+        mResponder = std::make_shared<const ApduResponder>(responder);
+        mIsCardPresent = true;
+        mIsPhysicalChannelOpen = false;
+        mPowerOnData.clear();
+
+        mCondition.notify_all();
+        if (mReadinessEvent) {
+            mReadinessEvent->signal();
+        }
+    }
+
+    /**
+     * Removes the simulated card, if any, closing the physical channel.
+     *
+     * @since 2.1.0
+     */
+    void removeCard()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mResponder.reset();
+        mIsCardPresent = false;
+        mIsPhysicalChannelOpen = false;
+        mPowerOnData.clear();
+
+        mCondition.notify_all();
+        if (mReadinessEvent) {
+            mReadinessEvent->signal();
+        }
+    }
+
+    /**
+     * Sets the duration added to each opening of the physical channel and to each APDU exchange.
+     *
+     * @param latency The latency (0 by default).
+     * @since 2.1.0
+     */
+    void setLatency(const std::chrono::microseconds& latency)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mLatency = latency;
+    }
+
+    /**
+     * Sets the rate of injected errors: each opening of the physical channel and each APDU
+     * exchange fails with a CardIOException, and each card presence check with a
+     * ReaderIOException, with this probability.
+     *
+     * @param errorRate The probability, between 0 (default) and 1.
+     * @param seed The seed of the generator drawing the errors.
+     * @since 2.1.0
+     */
+    void setErrorRate(const double errorRate, const uint32_t seed = 1)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mErrorRate = errorRate;
+        mRandom.seed(seed);
+    }
+
+    /**
+     * Gets the number of APDU commands successfully answered since the creation of the reader.
+     *
+     * @return A positive number.
+     * @since 2.1.0
+     */
+    uint64_t getTransmittedApduCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mTransmittedApduCount;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string& getName() const override
+    {
+        return mName;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void openPhysicalChannel() override
+    {
+        tryOpenPhysicalChannel().throwIfError();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryOpenPhysicalChannel() noexcept override
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        simulateLatency(lock);
+
+        if (!mIsCardPresent) {
+            return ReaderStatus(ReaderStatus::Code::CARD_IO_ERROR, "No card present");
+        }
+
+        if (isErrorInjected()) {
+            return ReaderStatus(ReaderStatus::Code::CARD_IO_ERROR,
+                                "Injected error while opening the physical channel");
+        }
+
+        if (!mIsPhysicalChannelOpen) {
+            mPowerOnData.set(mCardPowerOnData.data(), mCardPowerOnData.size());
+            mIsPhysicalChannelOpen = true;
+        }
+
+        return ReaderStatus();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void closePhysicalChannel() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mIsPhysicalChannelOpen = false;
+        mPowerOnData.clear();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isPhysicalChannelOpen() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mIsPhysicalChannelOpen;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool checkCardPresence() override
+    {
+        bool isCardPresent = false;
+        tryCheckCardPresence(isCardPresent).throwIfError();
+
+        return isCardPresent;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryCheckCardPresence(bool& isCardPresent) noexcept override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (isErrorInjected()) {
+            return ReaderStatus(ReaderStatus::Code::READER_IO_ERROR,
+                                "Injected error while checking the card presence");
+        }
+
+        isCardPresent = mIsCardPresent;
+
+        return ReaderStatus();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string getPowerOnData() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPowerOnData.getHexString();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const PowerOnDataView getPowerOnDataView() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPowerOnData.getView();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const ParsedPowerOnData> getParsedPowerOnData() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mPowerOnData.getParsed();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override
+    {
+        std::shared_ptr<const ApduResponder> responder;
+        beginTransmission(responder).throwIfError();
+
+        const std::vector<uint8_t> apduOut = (*responder)(apduIn);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTransmittedApduCount++;
+
+        return apduOut;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>An exception raised by the responder is reported as CARD_IO_ERROR.
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus tryTransmitApdu(const uint8_t* apduIn,
+                                 const std::size_t apduInLength,
+                                 uint8_t* apduOut,
+                                 const std::size_t apduOutCapacity,
+                                 std::size_t& apduOutLength) noexcept override
+    {
+        std::shared_ptr<const ApduResponder> responder;
+        const ReaderStatus status = beginTransmission(responder);
+        if (!status.isOk()) {
+            return status;
+        }
+
+        std::vector<uint8_t> apduResponse;
+        try {
+            apduResponse = (*responder)(std::vector<uint8_t>(apduIn, apduIn + apduInLength));
+        } catch (...) {
+            return ReaderStatus(ReaderStatus::Code::CARD_IO_ERROR, "APDU responder failed");
+        }
+
+        if (apduResponse.size() > apduOutCapacity) {
+            return ReaderStatus(ReaderStatus::Code::INVALID_ARGUMENT,
+                                "Response buffer too small");
+        }
+
+        std::copy(apduResponse.begin(), apduResponse.end(), apduOut);
+        apduOutLength = apduResponse.size();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTransmittedApduCount++;
+
+        return ReaderStatus();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() override
+    {
+        return mIsContactless;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onUnregister() override {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onStartDetection() override {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void onStopDetection() override {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void waitForCardInsertion() override
+    {
+        waitForCardPresence(true);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    WaitStatus waitForCardInsertionUntil(
+        const std::chrono::steady_clock::time_point& deadline) override
+    {
+        return waitForCardPresenceUntil(true, deadline);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isCardInsertionDeadlineSupported() const override
+    {
+        return true;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void stopWaitForCardInsertion() override
+    {
+        stopWait(mInsertionStop);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void waitForCardRemoval() override
+    {
+        waitForCardPresence(false);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    WaitStatus waitForCardRemovalUntil(
+        const std::chrono::steady_clock::time_point& deadline) override
+    {
+        return waitForCardPresenceUntil(false, deadline);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool isCardRemovalDeadlineSupported() const override
+    {
+        return true;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void stopWaitForCardRemoval() override
+    {
+        stopWait(mRemovalStop);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The underlying event is created on the first invocation, so that readers which are never
+     * multiplexed do not use any system resource.
+     *
+     * @throw IllegalStateException If the event cannot be created.
+     * @since 2.1.0
+     */
+    ReadinessHandle getReadinessHandle() const override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (!mReadinessEvent) {
+            mReadinessEvent.reset(new ReadinessEvent());
+        }
+
+        return mReadinessEvent->getHandle();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void acknowledgeReadiness() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mReadinessEvent) {
+            mReadinessEvent->clear();
+        }
+    }
+
+private:
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     *
+     */
+    const bool mIsContactless;
+
+    /**
+     *
+     */
+    bool mIsCardPresent;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mCardPowerOnData;
+
+    /**
+     *
+     */
+    std::shared_ptr<const ApduResponder> mResponder;
+
+    /**
+     *
+     */
+    bool mIsPhysicalChannelOpen;
+
+    /**
+     *
+     */
+    PowerOnDataCache mPowerOnData;
+
+    /**
+     * Stop requests of a kind of wait. A request not handled yet cancels the current wait, or the
+     * next one if no wait is in progress.
+     */
+    struct StopEpoch {
+        StopEpoch() : mRequested(0), mHandled(0) {}
+
+        uint64_t mRequested;
+        uint64_t mHandled;
+    };
+
+    /**
+     *
+     */
+    StopEpoch mInsertionStop;
+
+    /**
+     *
+     */
+    StopEpoch mRemovalStop;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mLatency;
+
+    /**
+     *
+     */
+    double mErrorRate;
+
+    /**
+     *
+     */
+    std::minstd_rand mRandom;
+
+    /**
+     *
+     */
+    uint64_t mTransmittedApduCount;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     *
+     */
+    std::condition_variable mCondition;
+
+    /**
+     * Created by getReadinessHandle().
+     */
+    mutable std::unique_ptr<ReadinessEvent> mReadinessEvent;
+
+    /**
+     * Sleeps for the configured latency, without holding the lock.
+     */
+    void simulateLatency(std::unique_lock<std::mutex>& lock)
+    {
+        if (mLatency.count() != 0) {
+            const std::chrono::microseconds latency = mLatency;
+            lock.unlock();
+            std::this_thread::sleep_for(latency);
+            lock.lock();
+        }
+    }
+
+    /**
+     * Applies the latency and the error injection of an APDU exchange, and gets the responder.
+     */
+    ReaderStatus beginTransmission(std::shared_ptr<const ApduResponder>& responder)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        simulateLatency(lock);
+
+        if (!mIsPhysicalChannelOpen) {
+            return ReaderStatus(ReaderStatus::Code::CARD_IO_ERROR, "Physical channel not open");
+        }
+
+        if (isErrorInjected()) {
+            return ReaderStatus(ReaderStatus::Code::CARD_IO_ERROR,
+                                "Injected error while transmitting an APDU");
+        }
+
+        responder = mResponder;
+
+        return ReaderStatus();
+    }
+
+    /**
+     * Must be invoked with the lock held.
+     */
+    bool isErrorInjected()
+    {
+        return mErrorRate > 0 &&
+               std::uniform_real_distribution<double>(0, 1)(mRandom) < mErrorRate;
+    }
+
+    /**
+     *
+     */
+    void waitForCardPresence(const bool isCardPresent)
+    {
+        if (waitForCardPresenceUntil(isCardPresent,
+                                     std::chrono::steady_clock::time_point::max()) !=
+            WaitStatus::COMPLETED) {
+            throw TaskCanceledException(0, "The wait has been stopped");
+        }
+    }
+
+    /**
+     *
+     */
+    WaitStatus waitForCardPresenceUntil(const bool isCardPresent,
+                                        const std::chrono::steady_clock::time_point& deadline)
+    {
+        StopEpoch& stop = isCardPresent ? mInsertionStop : mRemovalStop;
+        const auto isOver = [this, isCardPresent, &stop] {
+            return stop.mRequested != stop.mHandled || mIsCardPresent == isCardPresent;
+        };
+
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            mCondition.wait(lock, isOver);
+        } else if (!mCondition.wait_until(lock, deadline, isOver)) {
+            return WaitStatus::TIMED_OUT;
+        }
+
+        if (stop.mRequested != stop.mHandled) {
+            stop.mHandled = stop.mRequested;
+            return WaitStatus::CANCELED;
+        }
+
+        return WaitStatus::COMPLETED;
+    }
+
+    /**
+     *
+     */
+    void stopWait(StopEpoch& stop)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        stop.mRequested++;
+        mCondition.notify_all();
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,65 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+/* Plugin */
+#include "EventDrivenObservablePluginApi.h"
+#include "ObservablePluginSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+using namespace keyple::core::plugin;
+
+/**
+ * Observable plugin (non pool) able to signal by itself the changes in its list of readers (for
+ * example a hot-plug notification from the operating system).
+ *
+ * <p>Once connected, Keyple Core no longer polls {@link #searchAvailableReaderNames()} at the
+ * pace given by {@link #getMonitoringCycleDuration()}: the readers list is only queried when the
+ * plugin notifies a change through the provided {@link EventDrivenObservablePluginApi}. Plugins
+ * that only implement {@link ObservablePluginSpi} keep being polled.
+ *
+ * @since 2.1.0
+ */
+class EventDrivenObservablePluginSpi : public ObservablePluginSpi {
+public:
+    /**
+     *
+     */
+    virtual ~EventDrivenObservablePluginSpi() = default;
+
+    /**
+     * Connects the associated Keyple Core {@link EventDrivenObservablePluginApi} API.
+     *
+     * <p>The plugin must notify any change occurring after this call. Changes occurring before are
+     * detected by an initial invocation of {@link #searchAvailableReaderNames()}.
+     *
+     * /!\ C++: cannot use a shared_ptr here as this function is called from constructors
+     *
+     * @param eventDrivenObservablePluginApi The API to connect.
+     * @since 2.1.0
+     */
+    virtual void connect(EventDrivenObservablePluginApi* eventDrivenObservablePluginApi) = 0;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,57 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <string>
+
+/* Plugin */
+#include "PoolPluginSpi.h"
+#include "ReaderGroupStatistics.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+/**
+ * Pool plugin exposing occupancy and contention statistics for each of its reader groups, so that
+ * pools can be sized from measured data.
+ *
+ * <p>See cpp::ReaderGroupStatisticsRecorder for a ready-to-use implementation of the counters.
+ *
+ * @since 2.1.0
+ */
+class MonitoredPoolPluginSpi : public virtual PoolPluginSpi {
+public:
+    /**
+     *
+     */
+    virtual ~MonitoredPoolPluginSpi() = default;
+
+    /**
+     * Gets the statistics of a reader group, as returned by {@link #getReaderGroupReferences()}.
+     *
+     * @param readerGroupReference The reader group reference.
+     * @return A snapshot of the counters.
+     * @throw IllegalArgumentException If the group reference is unknown.
+     * @throw PluginIOException If an error occurs
+     * @since 2.1.0
+     */
+    virtual const ReaderGroupStatistics getReaderGroupStatistics(
+        const std::string& readerGroupReference) const = 0;
+};
+
+}
+}
+}
+}
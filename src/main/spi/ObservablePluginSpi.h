@@ -12,9 +12,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 /* Plugin */
 #include "PluginSpi.h"
@@ -59,6 +61,53 @@ public:
      */
     virtual const std::vector<std::string> searchAvailableReaderNames() = 0;
 
+    /**
+     * Gets the current epoch of the readers list, incremented by the plugin on each connection or
+     * disconnection of a reader.
+     *
+     * <p>When the epoch is the same as the one observed during the previous monitoring cycle, the
+     * readers list is unchanged and does not need to be enumerated.
+     *
+     * <p>The default implementation returns 0, meaning that the plugin does not track epochs and
+     * that {@link #searchAvailableReaderNames()} must be used. See cpp::ReaderNamesJournal for a
+     * ready-to-use implementation.
+     *
+     * @return A positive number, or 0 if not supported.
+     * @since 2.1.0
+     */
+    virtual uint64_t getReaderNamesEpoch() const
+    {
+        return 0;
+    }
+
+    /**
+     * Gets the names of the readers connected and disconnected since the provided epoch.
+     *
+     * <p>A reader disconnected then connected again is reported in both lists.
+     *
+     * <p>The default implementation returns false, meaning that the plugin does not track changes
+     * and that {@link #searchAvailableReaderNames()} must be used.
+     *
+     * @param epoch An epoch previously returned by {@link #getReaderNamesEpoch()}.
+     * @param connectedReaderNames Filled with the names of the readers connected since the epoch.
+     * @param disconnectedReaderNames Filled with the names of the readers disconnected since the
+     *        epoch.
+     * @return False if the changes since the provided epoch are not known (not supported or too old
+     *         epoch), in which case the lists are left untouched.
+     * @throws PluginIOException If an error occurs while searching readers.
+     * @since 2.1.0
+     */
+    virtual bool searchReaderNamesChanges(const uint64_t epoch,
+                                          std::vector<std::string>& connectedReaderNames,
+                                          std::vector<std::string>& disconnectedReaderNames)
+    {
+        (void)epoch;
+        (void)connectedReaderNames;
+        (void)disconnectedReaderNames;
+
+        return false;
+    }
+
     /**
      * Searches for the reader whose name is provided and returns its {@link ReaderSpi} if found,
      * null if not.
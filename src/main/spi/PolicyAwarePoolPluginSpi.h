@@ -0,0 +1,72 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+
+/* Plugin */
+#include "PoolPluginSpi.h"
+#include "ReaderAllocationPolicySpi.h"
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Pool plugin whose choice of the allocated reader within a group is delegated to a configurable
+ * {@link ReaderAllocationPolicySpi}.
+ *
+ * @since 2.1.0
+ */
+class PolicyAwarePoolPluginSpi : public virtual PoolPluginSpi {
+public:
+    /**
+     *
+     */
+    virtual ~PolicyAwarePoolPluginSpi() = default;
+
+    /**
+     * Sets the allocation policy of a reader group.
+     *
+     * @param readerGroupReference The reader group reference.
+     * @param allocationPolicy The policy to use.
+     * @throw IllegalArgumentException If the group reference is unknown or the policy is null.
+     * @since 2.1.0
+     */
+    virtual void setAllocationPolicy(
+        const std::string& readerGroupReference,
+        std::shared_ptr<ReaderAllocationPolicySpi> allocationPolicy) = 0;
+
+    /**
+     * Same as {@link #allocateReader(const std::string&)}, providing an affinity key to the
+     * allocation policy of the group.
+     *
+     * @param readerGroupReference The reader group reference (optional)
+     * @param affinityKey An identifier of the card or client served (for example to prefer the
+     *        reader that served it last time).
+     * @return A not null reference
+     * @throw PluginIOException If an error occurs
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<ReaderSpi> allocateReaderWithAffinity(
+        const std::string& readerGroupReference, const std::string& affinityKey) = 0;
+};
+
+}
+}
+}
+}
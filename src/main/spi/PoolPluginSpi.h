@@ -12,9 +12,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <exception>
 #include <string.h>
+#include <vector>
 
 /* Plugin */
+#include "PluginIOException.h"
 #include "ReaderSpi.h"
 #include "PluginSpi.h"
 #include "PoolPluginSpi.h"
@@ -32,6 +36,24 @@ namespace spi {
  */
 class PoolPluginSpi {
 public:
+    /**
+     * Behaviour of {@link #allocateReaders(const std::string&, const std::size_t,
+     * const BulkAllocationMode)} when not all the requested readers can be allocated.
+     *
+     * @since 2.1.0
+     */
+    enum class BulkAllocationMode {
+        /**
+         * The readers already allocated are released and the error is raised.
+         */
+        ALL_OR_NOTHING,
+
+        /**
+         * The readers already allocated are returned, possibly fewer than requested.
+         */
+        BEST_EFFORT
+    };
+
     /**
      *
      */
@@ -84,12 +106,106 @@ public:
      */
     virtual void releaseReader(std::shared_ptr<ReaderSpi> readerSpi) = 0;
 
+    /**
+     * Obtains several readers of the same group at once, each of them being exclusive to the
+     * caller until released.
+     *
+     * <p>The default implementation invokes {@link #allocateReader(const std::string&)} for each
+     * reader. Plugins should override it to allocate the readers while taking their internal lock
+     * once (or in a single round trip for remote pools).
+     *
+     * @param readerGroupReference The reader group reference (optional)
+     * @param readerCount The number of readers requested.
+     * @param mode The behaviour when not all the readers can be allocated.
+     * @return The allocated readers: exactly readerCount in ALL_OR_NOTHING mode, at most
+     *         readerCount in BEST_EFFORT mode.
+     * @throw PluginIOException If an error occurs (in ALL_OR_NOTHING mode, no reader remains
+     *        allocated). Any other exception is propagated as well, after the release of the
+     *        readers already allocated, whatever the mode.
+     * @since 2.1.0
+     */
+    virtual std::vector<std::shared_ptr<ReaderSpi>> allocateReaders(
+        const std::string& readerGroupReference,
+        const std::size_t readerCount,
+        const BulkAllocationMode mode)
+    {
+        std::vector<std::shared_ptr<ReaderSpi>> readerSpis;
+        readerSpis.reserve(readerCount);
+
+        try {
+            while (readerSpis.size() < readerCount) {
+                readerSpis.push_back(allocateReader(readerGroupReference));
+            }
+
+        } catch (const PluginIOException&) {
+            if (mode == BulkAllocationMode::ALL_OR_NOTHING) {
+                rollBack(readerSpis);
+                throw;
+            }
+
+        } catch (...) {
+            /* Not a lack of readers: the readers already allocated are released in any mode */
+            rollBack(readerSpis);
+            throw;
+        }
+
+        return readerSpis;
+    }
+
+    /**
+     * Releases several readers previously allocated.
+     *
+     * <p>The default implementation invokes {@link #releaseReader(std::shared_ptr<ReaderSpi>)} for
+     * each reader. All the readers are released even if some releases fail.
+     *
+     * @param readerSpis The readers to deallocate
+     * @throw PluginIOException If an error occurs (the first error, whatever its type, is raised
+     *        once all the readers have been processed).
+     * @since 2.1.0
+     */
+    virtual void releaseReaders(const std::vector<std::shared_ptr<ReaderSpi>>& readerSpis)
+    {
+        std::exception_ptr firstError;
+
+        for (const auto& readerSpi : readerSpis) {
+            try {
+                releaseReader(readerSpi);
+            } catch (...) {
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+    }
+
     /**
      * Invoked when unregistering the plugin.
      *
      * @since 2.0.0
      */
     virtual void onUnregister() = 0;
+
+protected:
+    /**
+     * Releases the provided readers, ignoring the errors.
+     *
+     * @param readerSpis The readers to release.
+     * @since 2.1.0
+     */
+    void rollBack(const std::vector<std::shared_ptr<ReaderSpi>>& readerSpis)
+    {
+        for (const auto& readerSpi : readerSpis) {
+            try {
+                releaseReader(readerSpi);
+            } catch (...) {
+                /* Rollback is best effort */
+            }
+        }
+    }
 };
 
 }
@@ -0,0 +1,104 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Plugin */
+#include "ReaderSpi.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Strategy choosing which free reader of a group a pool plugin allocates (for example round-robin,
+ * least recently used, sticky affinity or lowest latency; see the implementations provided in the
+ * cpp namespace).
+ *
+ * <p>The pool plugin invokes the policy while it holds the lock of the group, so {@link
+ * #selectReader(const std::vector<std::shared_ptr<ReaderSpi>>&, const std::string&)} must be
+ * fast. A policy instance may be shared between several groups and must be thread-safe.
+ *
+ * @since 2.1.0
+ */
+class ReaderAllocationPolicySpi {
+public:
+    /**
+     *
+     */
+    virtual ~ReaderAllocationPolicySpi() = default;
+
+    /**
+     * Chooses the reader to allocate among the free readers of the group.
+     *
+     * @param freeReaders The free readers of the group (not empty).
+     * @param affinityKey The affinity key provided by the caller (for example a card or client
+     *        identifier), empty if none.
+     * @return The index of the chosen reader in freeReaders.
+     * @since 2.1.0
+     */
+    virtual std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                                     const std::string& affinityKey) = 0;
+
+    /**
+     * Invoked by the pool plugin once the reader chosen by the policy has been allocated.
+     *
+     * @param readerSpi The allocated reader.
+     * @param affinityKey The affinity key provided by the caller, empty if none.
+     * @since 2.1.0
+     */
+    virtual void onReaderAllocated(const std::shared_ptr<ReaderSpi>& readerSpi,
+                                   const std::string& affinityKey)
+    {
+        (void)readerSpi;
+        (void)affinityKey;
+    }
+
+    /**
+     * Invoked by the pool plugin when a reader has been released.
+     *
+     * @param readerSpi The released reader.
+     * @since 2.1.0
+     */
+    virtual void onReaderReleased(const std::shared_ptr<ReaderSpi>& readerSpi)
+    {
+        (void)readerSpi;
+    }
+
+    /**
+     * Invoked by whoever measures the latency of the readers (for example an instrumentation
+     * decorator), for the policies taking it into account.
+     *
+     * @param readerSpi The measured reader.
+     * @param latency The measured latency of an operation.
+     * @since 2.1.0
+     */
+    virtual void onLatencyMeasured(const std::shared_ptr<ReaderSpi>& readerSpi,
+                                   const std::chrono::nanoseconds& latency)
+    {
+        (void)readerSpi;
+        (void)latency;
+    }
+};
+
+}
+}
+}
+}
@@ -0,0 +1,183 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+/**
+ * Snapshot of the occupancy and contention counters of a reader group (see
+ * MonitoredPoolPluginSpi).
+ *
+ * <p>The allocation wait times are given as a histogram with power-of-two buckets: bucket 0 counts
+ * the waits shorter than 1 microsecond, bucket i the waits in [2^(i-1), 2^i) microseconds and the
+ * last bucket all the longer ones.
+ *
+ * @since 2.1.0
+ */
+class ReaderGroupStatistics final {
+public:
+    /**
+     * @param totalReaderCount The number of readers of the group.
+     * @param freeReaderCount The number of readers currently free.
+     * @param allocationCount The number of successful allocations.
+     * @param allocationFailureCount The number of failed or timed out allocations.
+     * @param allocationWaitTimeHistogram The bucket counts of the allocation wait times.
+     * @param meanHoldTime The mean time between allocation and release of a reader.
+     * @since 2.1.0
+     */
+    ReaderGroupStatistics(const std::size_t totalReaderCount,
+                          const std::size_t freeReaderCount,
+                          const uint64_t allocationCount,
+                          const uint64_t allocationFailureCount,
+                          const std::vector<uint64_t>& allocationWaitTimeHistogram,
+                          const std::chrono::microseconds& meanHoldTime)
+    : mTotalReaderCount(totalReaderCount),
+      mFreeReaderCount(freeReaderCount),
+      mAllocationCount(allocationCount),
+      mAllocationFailureCount(allocationFailureCount),
+      mAllocationWaitTimeHistogram(allocationWaitTimeHistogram),
+      mMeanHoldTime(meanHoldTime) {}
+
+    /**
+     * Gets the exclusive upper bound of a bucket of the wait time histogram.
+     *
+     * @param bucketIndex The index of the bucket (except the last one).
+     * @return 2^bucketIndex microseconds.
+     * @since 2.1.0
+     */
+    static std::chrono::microseconds getHistogramBucketUpperBound(const std::size_t bucketIndex)
+    {
+        return std::chrono::microseconds(static_cast<int64_t>(1) << bucketIndex);
+    }
+
+    /**
+     * Gets the number of readers of the group.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    std::size_t getTotalReaderCount() const
+    {
+        return mTotalReaderCount;
+    }
+
+    /**
+     * Gets the number of readers currently free.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    std::size_t getFreeReaderCount() const
+    {
+        return mFreeReaderCount;
+    }
+
+    /**
+     * Gets the number of readers currently allocated.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    std::size_t getAllocatedReaderCount() const
+    {
+        return mTotalReaderCount - mFreeReaderCount;
+    }
+
+    /**
+     * Gets the number of successful allocations.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    uint64_t getAllocationCount() const
+    {
+        return mAllocationCount;
+    }
+
+    /**
+     * Gets the number of allocations that failed or timed out.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    uint64_t getAllocationFailureCount() const
+    {
+        return mAllocationFailureCount;
+    }
+
+    /**
+     * Gets the bucket counts of the allocation wait times.
+     *
+     * @return A not empty list.
+     * @since 2.1.0
+     */
+    const std::vector<uint64_t>& getAllocationWaitTimeHistogram() const
+    {
+        return mAllocationWaitTimeHistogram;
+    }
+
+    /**
+     * Gets the mean time between the allocation and the release of a reader.
+     *
+     * @return Zero if no reader has been released yet.
+     * @since 2.1.0
+     */
+    const std::chrono::microseconds& getMeanHoldTime() const
+    {
+        return mMeanHoldTime;
+    }
+
+private:
+    /**
+     *
+     */
+    std::size_t mTotalReaderCount;
+
+    /**
+     *
+     */
+    std::size_t mFreeReaderCount;
+
+    /**
+     *
+     */
+    uint64_t mAllocationCount;
+
+    /**
+     *
+     */
+    uint64_t mAllocationFailureCount;
+
+    /**
+     *
+     */
+    std::vector<uint64_t> mAllocationWaitTimeHistogram;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mMeanHoldTime;
+};
+
+}
+}
+}
+}
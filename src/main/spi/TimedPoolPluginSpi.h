@@ -0,0 +1,115 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+
+/* Plugin */
+#include "PoolPluginSpi.h"
+#include "ReaderSpi.h"
+#include "WaitStatus.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * Pool plugin offering bounded waits when allocating readers, so that callers can apply
+ * backpressure instead of holding threads until a reader is free.
+ *
+ * @since 2.1.0
+ */
+class TimedPoolPluginSpi : public virtual PoolPluginSpi {
+public:
+    /**
+     * Callback of {@link #allocateReaderAsync(const std::string&, const AllocationCallback&)}.
+     * The reader is null when an error is reported.
+     *
+     * @since 2.1.0
+     */
+    using AllocationCallback =
+        std::function<void(std::shared_ptr<ReaderSpi> readerSpi, std::exception_ptr error)>;
+
+    /**
+     *
+     */
+    virtual ~TimedPoolPluginSpi() = default;
+
+    /**
+     * Obtains a reader of the group only if one is free right now, without waiting.
+     *
+     * @param readerGroupReference The reader group reference (optional)
+     * @return Null if no reader of the group is free.
+     * @throw PluginIOException If an error occurs
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<ReaderSpi> tryAllocateReader(
+        const std::string& readerGroupReference) = 0;
+
+    /**
+     * Obtains a reader of the group, waiting at most until the provided deadline for one to be
+     * released.
+     *
+     * @param readerGroupReference The reader group reference (optional)
+     * @param deadline The point in time after which the call gives up.
+     * @return Null if no reader of the group became free before the deadline.
+     * @throw PluginIOException If an error occurs
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<ReaderSpi> tryAllocateReaderUntil(
+        const std::string& readerGroupReference,
+        const std::chrono::steady_clock::time_point& deadline) = 0;
+
+    /**
+     * Obtains a reader of the group, waiting at most the provided duration for one to be released.
+     *
+     * @param readerGroupReference The reader group reference (optional)
+     * @param timeout The maximum waiting time, infinite if too large to be represented as a
+     *     deadline.
+     * @return Null if no reader of the group became free in time.
+     * @throw PluginIOException If an error occurs
+     * @since 2.1.0
+     */
+    std::shared_ptr<ReaderSpi> tryAllocateReaderFor(const std::string& readerGroupReference,
+                                                    const std::chrono::milliseconds& timeout)
+    {
+        return tryAllocateReaderUntil(readerGroupReference,
+                                      reader::observable::getDeadline(timeout));
+    }
+
+    /**
+     * Requests a reader of the group and returns immediately; the callback is invoked exactly once,
+     * from any thread, as soon as a reader of the group is allocated to the caller or an error
+     * occurs.
+     *
+     * <p>Pending requests of a group are served in their order of arrival.
+     *
+     * @param readerGroupReference The reader group reference (optional)
+     * @param callback Invoked with the allocated reader or the PluginIOException raised.
+     * @since 2.1.0
+     */
+    virtual void allocateReaderAsync(const std::string& readerGroupReference,
+                                     const AllocationCallback& callback) = 0;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,86 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/* Plugin */
+#include "PoolPluginSpi.h"
+#include "WarmPoolStatistics.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+/**
+ * Pool plugin able to keep readers pre-powered, with their physical channel already open, so that
+ * {@link #allocateReader(const std::string&)} hands them out in constant time (for example a SAM
+ * farm whose card reset is slow).
+ *
+ * <p>A reader obtained from the warm pool is returned with its physical channel open. On release,
+ * the plugin may keep the channel open and put the reader back in the warm pool, or close it when
+ * the warm pool of the group is full.
+ *
+ * @since 2.1.0
+ */
+class WarmPoolPluginSpi : public virtual PoolPluginSpi {
+public:
+    /**
+     *
+     */
+    virtual ~WarmPoolPluginSpi() = default;
+
+    /**
+     * Sets the number of free readers of the group that the plugin must keep warm.
+     *
+     * <p>The plugin warms up additional readers, possibly in the background; setting 0 disables
+     * the warm pool of the group and closes the channels of its free warm readers.
+     *
+     * @param readerGroupReference The reader group reference.
+     * @param warmPoolSize The number of warm readers to keep.
+     * @throw IllegalArgumentException If the group reference is unknown.
+     * @throw ReaderIOException If the physical channel of a reader cannot be opened or closed.
+     * @throw PluginIOException If an error occurs
+     * @since 2.1.0
+     */
+    virtual void setWarmPoolSize(const std::string& readerGroupReference,
+                                 const std::size_t warmPoolSize) = 0;
+
+    /**
+     * Gets the number of free readers of the group that the plugin keeps warm.
+     *
+     * @param readerGroupReference The reader group reference.
+     * @return 0 if the warm pool is disabled for this group.
+     * @throw IllegalArgumentException If the group reference is unknown.
+     * @since 2.1.0
+     */
+    virtual std::size_t getWarmPoolSize(const std::string& readerGroupReference) const = 0;
+
+    /**
+     * Gets the warm pool counters of the group.
+     *
+     * @param readerGroupReference The reader group reference.
+     * @return A snapshot of the counters.
+     * @throw IllegalArgumentException If the group reference is unknown.
+     * @since 2.1.0
+     */
+    virtual const WarmPoolStatistics getWarmPoolStatistics(
+        const std::string& readerGroupReference) const = 0;
+};
+
+}
+}
+}
+}
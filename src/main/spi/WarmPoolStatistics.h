@@ -0,0 +1,94 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+
+/**
+ * Snapshot of the warm pool counters of a reader group (see WarmPoolPluginSpi).
+ *
+ * @since 2.1.0
+ */
+class WarmPoolStatistics final {
+public:
+    /**
+     * @param warmReaderCount The number of readers currently warm and free.
+     * @param hitCount The number of allocations served by a warm reader.
+     * @param missCount The number of allocations that had to open the channel.
+     * @since 2.1.0
+     */
+    WarmPoolStatistics(const std::size_t warmReaderCount,
+                       const uint64_t hitCount,
+                       const uint64_t missCount)
+    : mWarmReaderCount(warmReaderCount), mHitCount(hitCount), mMissCount(missCount) {}
+
+    /**
+     * Gets the number of readers currently warm and free.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    std::size_t getWarmReaderCount() const
+    {
+        return mWarmReaderCount;
+    }
+
+    /**
+     * Gets the number of allocations served by a warm reader.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    uint64_t getHitCount() const
+    {
+        return mHitCount;
+    }
+
+    /**
+     * Gets the number of allocations that had to open the channel of the allocated reader.
+     *
+     * @return A positive or zero number.
+     * @since 2.1.0
+     */
+    uint64_t getMissCount() const
+    {
+        return mMissCount;
+    }
+
+private:
+    /**
+     *
+     */
+    std::size_t mWarmReaderCount;
+
+    /**
+     *
+     */
+    uint64_t mHitCount;
+
+    /**
+     *
+     */
+    uint64_t mMissCount;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,155 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+
+/**
+ * Completion-based variant of {@link ReaderSpi}, for plugins whose I/O stack is non-blocking.
+ *
+ * <p>Each I/O operation returns immediately and reports its outcome by invoking the provided
+ * callback exactly once, from any thread (possibly the calling one). A single event loop can
+ * therefore drive many readers without dedicating a thread to each of them.
+ *
+ * <p>The error argument of the callbacks is null on success. Otherwise it holds the exception the
+ * synchronous method would have thrown (ReaderIOException or CardIOException), so that it can be
+ * rethrown with std::rethrow_exception.
+ *
+ * <p>See cpp::AsyncReaderSpiAdapter and cpp::BlockingReaderSpiAdapter to convert from and to a
+ * synchronous {@link ReaderSpi}.
+ *
+ * @since 2.1.0
+ */
+class AsyncReaderSpi {
+public:
+    /**
+     * Callback of the operations without result.
+     *
+     * @since 2.1.0
+     */
+    using CompletionCallback = std::function<void(std::exception_ptr error)>;
+
+    /**
+     * Callback of {@link #checkCardPresence(const CardPresenceCallback&)}.
+     *
+     * @since 2.1.0
+     */
+    using CardPresenceCallback = std::function<void(bool isCardPresent, std::exception_ptr error)>;
+
+    /**
+     * Callback of {@link #transmitApdu(const std::vector<uint8_t>&, const TransmitApduCallback&)}.
+     * The response is empty when an error is reported.
+     *
+     * @since 2.1.0
+     */
+    using TransmitApduCallback =
+        std::function<void(const std::vector<uint8_t>& apduOut, std::exception_ptr error)>;
+
+    /**
+     *
+     */
+    virtual ~AsyncReaderSpi() = default;
+
+    /**
+     * Gets the name of the reader.
+     *
+     * @return A not empty string.
+     * @since 2.1.0
+     */
+    virtual const std::string& getName() const = 0;
+
+    /**
+     * Starts opening the physical channel.
+     *
+     * @param callback Invoked once the operation is complete.
+     * @since 2.1.0
+     */
+    virtual void openPhysicalChannel(const CompletionCallback& callback) = 0;
+
+    /**
+     * Starts closing the current physical channel.
+     *
+     * @param callback Invoked once the operation is complete.
+     * @since 2.1.0
+     */
+    virtual void closePhysicalChannel(const CompletionCallback& callback) = 0;
+
+    /**
+     * Tells if the physical channel is open or not.
+     *
+     * @return True is the physical channel is open, false if not.
+     * @since 2.1.0
+     */
+    virtual bool isPhysicalChannelOpen() const = 0;
+
+    /**
+     * Starts verifying the presence of a card.
+     *
+     * @param callback Invoked with the result once the operation is complete.
+     * @since 2.1.0
+     */
+    virtual void checkCardPresence(const CardPresenceCallback& callback) = 0;
+
+    /**
+     * Gets the power-on data.
+     *
+     * @return A not empty string.
+     * @see ReaderSpi::getPowerOnData
+     * @since 2.1.0
+     */
+    virtual const std::string getPowerOnData() const = 0;
+
+    /**
+     * Starts transmitting an APDU.
+     *
+     * <p><b>Caution: the implementation must handle the case where the card response is 61xy and
+     * execute the appropriate get response command.</b>
+     *
+     * @param apduIn The data to be sent to the card (copied if needed beyond the call).
+     * @param callback Invoked with the card response once the operation is complete.
+     * @since 2.1.0
+     */
+    virtual void transmitApdu(const std::vector<uint8_t>& apduIn,
+                              const TransmitApduCallback& callback) = 0;
+
+    /**
+     * Tells if the reader is a contactless type.
+     *
+     * @return True if the reader a contactless type, false if not
+     * @since 2.1.0
+     */
+    virtual bool isContactless() = 0;
+
+    /**
+     * Invoked when unregistering the associated plugin.
+     *
+     * @since 2.1.0
+     */
+    virtual void onUnregister() = 0;
+};
+
+}
+}
+}
+}
+}
@@ -0,0 +1,139 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+
+/**
+ * APDU command of a batch transmitted with ReaderSpi::transmitApdus, together with its stop
+ * condition.
+ *
+ * <p>The stop condition is evaluated on the status word (the last two bytes) of the card response:
+ * when it does not belong to the list of successful status words and the command is flagged
+ * with stopOnUnsuccessfulStatusWord, the remaining commands of the batch are not transmitted.
+ *
+ * @since 2.1.0
+ */
+class BatchedApdu final {
+public:
+    /**
+     * Creates a command whose unsuccessful status words never interrupt the batch.
+     *
+     * @param apdu The data to be sent to the card.
+     * @since 2.1.0
+     */
+    explicit BatchedApdu(const std::vector<uint8_t>& apdu)
+    : mApdu(apdu), mSuccessfulStatusWords({0x9000}), mStopOnUnsuccessfulStatusWord(false) {}
+
+    /**
+     * @param apdu The data to be sent to the card.
+     * @param successfulStatusWords The status words considered as successful.
+     * @param stopOnUnsuccessfulStatusWord True if the batch must be interrupted when the response
+     *        status word is not successful.
+     * @since 2.1.0
+     */
+    BatchedApdu(const std::vector<uint8_t>& apdu,
+                const std::vector<int>& successfulStatusWords,
+                const bool stopOnUnsuccessfulStatusWord)
+    : mApdu(apdu),
+      mSuccessfulStatusWords(successfulStatusWords),
+      mStopOnUnsuccessfulStatusWord(stopOnUnsuccessfulStatusWord) {}
+
+    /**
+     * Gets the data to be sent to the card.
+     *
+     * @return A not empty buffer.
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t>& getApdu() const
+    {
+        return mApdu;
+    }
+
+    /**
+     * Gets the status words considered as successful.
+     *
+     * @return A not empty list.
+     * @since 2.1.0
+     */
+    const std::vector<int>& getSuccessfulStatusWords() const
+    {
+        return mSuccessfulStatusWords;
+    }
+
+    /**
+     * Tells if the batch must be interrupted when the response status word is not successful.
+     *
+     * @return True if the batch must be interrupted.
+     * @since 2.1.0
+     */
+    bool isStopOnUnsuccessfulStatusWord() const
+    {
+        return mStopOnUnsuccessfulStatusWord;
+    }
+
+    /**
+     * Tells if the provided card response ends the batch.
+     *
+     * @param apduResponse The card response to this command.
+     * @return True if no further command must be transmitted.
+     * @since 2.1.0
+     */
+    bool isStopping(const std::vector<uint8_t>& apduResponse) const
+    {
+        if (!mStopOnUnsuccessfulStatusWord) {
+            return false;
+        }
+
+        if (apduResponse.size() < 2) {
+            return true;
+        }
+
+        const int statusWord = (apduResponse[apduResponse.size() - 2] << 8) |
+                               apduResponse[apduResponse.size() - 1];
+
+        return std::find(mSuccessfulStatusWords.begin(),
+                         mSuccessfulStatusWords.end(),
+                         statusWord) == mSuccessfulStatusWords.end();
+    }
+
+private:
+    /**
+     *
+     */
+    const std::vector<uint8_t> mApdu;
+
+    /**
+     *
+     */
+    const std::vector<int> mSuccessfulStatusWords;
+
+    /**
+     *
+     */
+    const bool mStopOnUnsuccessfulStatusWord;
+};
+
+}
+}
+}
+}
+}
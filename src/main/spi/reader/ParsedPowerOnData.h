@@ -0,0 +1,521 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+
+/**
+ * Decoded power-on data of a card, computed once per physical channel opening (see
+ * ReaderSpi::getParsedPowerOnData).
+ *
+ * <p>Three formats are recognized:
+ *
+ * <ul>
+ *   <li>an ISO7816-3 ATR of a contact card: convention, protocols (TD bytes), historical bytes
+ *       and checksum,
+ *   <li>the virtual ATR built by PC/SC contactless readers (3B 8n 80 01 ...), whose historical
+ *       bytes either identify a storage card (standard and card name) or carry the historical
+ *       bytes of an ISO14443-4 card,
+ *   <li>a raw ISO14443-4 ATS (first byte TL equal to its length): FSCI, TA/TB/TC and historical
+ *       bytes.
+ * </ul>
+ *
+ * <p>The SAK and ATQA of the anti-collision stage are not part of these formats and are therefore
+ * not provided.
+ *
+ * <p>Parsing never fails: unrecognized or truncated data is reported with the UNKNOWN format, the
+ * raw bytes being still available.
+ *
+ * @since 2.1.0
+ */
+class ParsedPowerOnData final {
+public:
+    /**
+     * Format of the power-on data.
+     *
+     * @since 2.1.0
+     */
+    enum class Format {
+        UNKNOWN,
+        ATR,
+        ATS
+    };
+
+    /**
+     * Value returned by the getters of the optional fields when absent.
+     *
+     * @since 2.1.0
+     */
+    enum : int {
+        ABSENT = -1
+    };
+
+    /**
+     * Parses raw power-on data.
+     *
+     * @param data The first byte of the power-on data.
+     * @param size The number of bytes.
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    static const ParsedPowerOnData parse(const uint8_t* data, const std::size_t size)
+    {
+        ParsedPowerOnData parsed(data, size);
+
+        if (!parsed.parseAtr()) {
+            parsed = ParsedPowerOnData(data, size);
+            if (!parsed.parseAts()) {
+                parsed = ParsedPowerOnData(data, size);
+            }
+        }
+
+        return parsed;
+    }
+
+    /**
+     * Parses power-on data provided as an hexadecimal string (see ReaderSpi::getPowerOnData).
+     *
+     * @param hexString The power-on data.
+     * @return A not null reference, UNKNOWN format if the string is not hexadecimal.
+     * @since 2.1.0
+     */
+    static const ParsedPowerOnData parse(const std::string& hexString)
+    {
+        std::vector<uint8_t> data;
+        if (!decodeHex(hexString, data)) {
+            return ParsedPowerOnData(nullptr, 0);
+        }
+
+        return parse(data.data(), data.size());
+    }
+
+    /**
+     * Converts an hexadecimal string (see ReaderSpi::getPowerOnData) into bytes.
+     *
+     * @param hexString The string to convert.
+     * @param bytes Receives the bytes (emptied if the string is not hexadecimal).
+     * @return False if the string is not hexadecimal.
+     * @since 2.1.0
+     */
+    static bool decodeHex(const std::string& hexString, std::vector<uint8_t>& bytes)
+    {
+        bytes.clear();
+
+        if (hexString.size() % 2 != 0) {
+            return false;
+        }
+
+        bytes.reserve(hexString.size() / 2);
+        for (std::size_t i = 0; i < hexString.size(); i += 2) {
+            const int high = hexDigitValue(hexString[i]);
+            const int low = hexDigitValue(hexString[i + 1]);
+            if (high < 0 || low < 0) {
+                bytes.clear();
+                return false;
+            }
+            bytes.push_back(static_cast<uint8_t>((high << 4) | low));
+        }
+
+        return true;
+    }
+
+    /**
+     * Gets the format of the power-on data.
+     *
+     * @since 2.1.0
+     */
+    Format getFormat() const
+    {
+        return mFormat;
+    }
+
+    /**
+     * Gets the raw power-on data.
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t>& getRawData() const
+    {
+        return mRawData;
+    }
+
+    /**
+     * Tells if the power-on data comes from a contactless card (PC/SC virtual ATR or ATS).
+     *
+     * @since 2.1.0
+     */
+    bool isContactless() const
+    {
+        return mIsContactless;
+    }
+
+    /**
+     * Tells if the ATR uses the inverse convention (TS = 3F).
+     *
+     * @return False if not an ATR.
+     * @since 2.1.0
+     */
+    bool isInverseConvention() const
+    {
+        return mIsInverseConvention;
+    }
+
+    /**
+     * Tells if a transmission protocol is indicated by the ATR (T=0 when no protocol is indicated).
+     *
+     * @param protocol The protocol number T (0 to 15).
+     * @return False if not an ATR.
+     * @since 2.1.0
+     */
+    bool isProtocolIndicated(const int protocol) const
+    {
+        return protocol >= 0 && protocol < 16 && (mProtocols & (1 << protocol)) != 0;
+    }
+
+    /**
+     * Gets the interface byte TA1 of the ATR (clock rate conversion and baud rate adjustment).
+     *
+     * @return ABSENT if not present.
+     * @since 2.1.0
+     */
+    int getTa1() const
+    {
+        return mTa1;
+    }
+
+    /**
+     * Tells if the ATR check byte TCK is present and correct.
+     *
+     * @return False if not an ATR or if TCK is absent.
+     * @since 2.1.0
+     */
+    bool isChecksumValid() const
+    {
+        return mIsChecksumValid;
+    }
+
+    /**
+     * Gets the historical bytes (of the ATR or of the ATS).
+     *
+     * @return An empty list if none.
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t>& getHistoricalBytes() const
+    {
+        return mHistoricalBytes;
+    }
+
+    /**
+     * Gets the PC/SC standard byte identifying the protocol of a contactless storage card (for
+     * example 03 for ISO14443 A part 3).
+     *
+     * @return ABSENT if not a PC/SC storage card ATR.
+     * @since 2.1.0
+     */
+    int getPcscStandard() const
+    {
+        return mPcscStandard;
+    }
+
+    /**
+     * Gets the PC/SC card name of a contactless storage card (for example 0001 for Mifare Classic
+     * 1K).
+     *
+     * @return ABSENT if not a PC/SC storage card ATR.
+     * @since 2.1.0
+     */
+    int getPcscCardName() const
+    {
+        return mPcscCardName;
+    }
+
+    /**
+     * Gets the frame size indicator FSCI of the ATS.
+     *
+     * @return ABSENT if not an ATS.
+     * @since 2.1.0
+     */
+    int getAtsFsci() const
+    {
+        return mAtsFsci;
+    }
+
+    /**
+     * Gets the interface byte TA(1) of the ATS (supported bit rates).
+     *
+     * @return ABSENT if not present.
+     * @since 2.1.0
+     */
+    int getAtsTa() const
+    {
+        return mAtsTa;
+    }
+
+    /**
+     * Gets the interface byte TB(1) of the ATS (FWI and SFGI).
+     *
+     * @return ABSENT if not present.
+     * @since 2.1.0
+     */
+    int getAtsTb() const
+    {
+        return mAtsTb;
+    }
+
+    /**
+     * Gets the interface byte TC(1) of the ATS (NAD and CID support).
+     *
+     * @return ABSENT if not present.
+     * @since 2.1.0
+     */
+    int getAtsTc() const
+    {
+        return mAtsTc;
+    }
+
+private:
+    /**
+     *
+     */
+    Format mFormat;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mRawData;
+
+    /**
+     *
+     */
+    bool mIsContactless;
+
+    /**
+     *
+     */
+    bool mIsInverseConvention;
+
+    /**
+     * Bit T set for each protocol T indicated.
+     */
+    uint16_t mProtocols;
+
+    /**
+     *
+     */
+    int mTa1;
+
+    /**
+     *
+     */
+    bool mIsChecksumValid;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mHistoricalBytes;
+
+    /**
+     *
+     */
+    int mPcscStandard;
+
+    /**
+     *
+     */
+    int mPcscCardName;
+
+    /**
+     *
+     */
+    int mAtsFsci;
+
+    /**
+     *
+     */
+    int mAtsTa;
+
+    /**
+     *
+     */
+    int mAtsTb;
+
+    /**
+     *
+     */
+    int mAtsTc;
+
+    /**
+     * Creates an UNKNOWN instance holding the raw data.
+     */
+    ParsedPowerOnData(const uint8_t* data, const std::size_t size)
+    : mFormat(Format::UNKNOWN),
+      mRawData(data, data + size),
+      mIsContactless(false),
+      mIsInverseConvention(false),
+      mProtocols(0),
+      mTa1(ABSENT),
+      mIsChecksumValid(false),
+      mPcscStandard(ABSENT),
+      mPcscCardName(ABSENT),
+      mAtsFsci(ABSENT),
+      mAtsTa(ABSENT),
+      mAtsTb(ABSENT),
+      mAtsTc(ABSENT) {}
+
+    /**
+     * Parses the raw data as an ISO7816-3 ATR.
+     */
+    bool parseAtr()
+    {
+        const std::vector<uint8_t>& atr = mRawData;
+
+        if (atr.size() < 2 || (atr[0] != 0x3B && atr[0] != 0x3F)) {
+            return false;
+        }
+
+        mIsInverseConvention = atr[0] == 0x3F;
+
+        const std::size_t historicalBytesCount = atr[1] & 0x0F;
+        uint8_t y = atr[1] >> 4;
+        std::size_t pos = 2;
+        std::size_t interfaceGroup = 1;
+        bool isTckExpected = false;
+
+        while (true) {
+            if ((y & 0x01) && interfaceGroup == 1 && pos < atr.size()) {
+                mTa1 = atr[pos];
+            }
+
+            /* TA, TB and TC */
+            pos += ((y >> 0) & 1) + ((y >> 1) & 1) + ((y >> 2) & 1);
+
+            if (!(y & 0x08)) {
+                break;
+            }
+
+            /* TD */
+            if (pos >= atr.size()) {
+                return false;
+            }
+
+            const uint8_t protocol = atr[pos] & 0x0F;
+            mProtocols |= static_cast<uint16_t>(1 << protocol);
+            if (protocol != 0) {
+                isTckExpected = true;
+            }
+
+            y = atr[pos] >> 4;
+            pos++;
+            interfaceGroup++;
+        }
+
+        if (mProtocols == 0) {
+            mProtocols = 1;
+        }
+
+        if (pos + historicalBytesCount > atr.size()) {
+            return false;
+        }
+
+        mHistoricalBytes.assign(atr.begin() + pos, atr.begin() + pos + historicalBytesCount);
+        pos += historicalBytesCount;
+
+        if (isTckExpected && pos < atr.size()) {
+            uint8_t checksum = 0;
+            for (std::size_t i = 1; i <= pos; i++) {
+                checksum ^= atr[i];
+            }
+            mIsChecksumValid = checksum == 0;
+        }
+
+        /* PC/SC virtual ATR of a contactless card: 3B 8n 80 01 */
+        if (atr.size() >= 4 && (atr[1] & 0xF0) == 0x80 && atr[2] == 0x80 && atr[3] == 0x01) {
+            mIsContactless = true;
+
+            static const uint8_t PCSC_RID[] = {0x80, 0x4F, 0x0C, 0xA0, 0x00, 0x00, 0x03, 0x06};
+            if (mHistoricalBytes.size() >= 11 &&
+                std::equal(PCSC_RID, PCSC_RID + sizeof(PCSC_RID), mHistoricalBytes.begin())) {
+                mPcscStandard = mHistoricalBytes[8];
+                mPcscCardName = (mHistoricalBytes[9] << 8) | mHistoricalBytes[10];
+            }
+        }
+
+        mFormat = Format::ATR;
+
+        return true;
+    }
+
+    /**
+     * Parses the raw data as an ISO14443-4 ATS.
+     */
+    bool parseAts()
+    {
+        const std::vector<uint8_t>& ats = mRawData;
+
+        if (ats.empty() || ats[0] != ats.size()) {
+            return false;
+        }
+
+        std::size_t pos = 1;
+        if (ats.size() > 1) {
+            const uint8_t t0 = ats[pos++];
+            mAtsFsci = t0 & 0x0F;
+            if ((t0 & 0x10) && pos < ats.size()) {
+                mAtsTa = ats[pos++];
+            }
+            if ((t0 & 0x20) && pos < ats.size()) {
+                mAtsTb = ats[pos++];
+            }
+            if ((t0 & 0x40) && pos < ats.size()) {
+                mAtsTc = ats[pos++];
+            }
+        }
+
+        mHistoricalBytes.assign(ats.begin() + pos, ats.end());
+        mIsContactless = true;
+        mFormat = Format::ATS;
+
+        return true;
+    }
+
+    /**
+     *
+     */
+    static int hexDigitValue(const char c)
+    {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+
+        return -1;
+    }
+};
+
+}
+}
+}
+}
+}
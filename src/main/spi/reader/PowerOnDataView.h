@@ -0,0 +1,117 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+
+/**
+ * Non-owning view of the raw power-on data (ATR) of a reader, as returned by
+ * ReaderSpi::getPowerOnDataView.
+ *
+ * <p>The bytes belong to the reader and remain valid until the next opening or closing of its
+ * physical channel. The generation number changes each time the power-on data changes, so it can
+ * be used as a key to cache any structure derived from the bytes (for example a parsed ATR).
+ *
+ * @since 2.1.0
+ */
+class PowerOnDataView final {
+public:
+    /**
+     * Creates an invalid view (generation 0), meaning that the reader does not provide the raw
+     * power-on data.
+     *
+     * @since 2.1.0
+     */
+    PowerOnDataView() : mData(nullptr), mSize(0), mGeneration(0) {}
+
+    /**
+     * @param data The first byte of the power-on data.
+     * @param size The number of bytes.
+     * @param generation The positive generation number of the data.
+     * @since 2.1.0
+     */
+    PowerOnDataView(const uint8_t* data, const std::size_t size, const uint64_t generation)
+    : mData(data), mSize(size), mGeneration(generation) {}
+
+    /**
+     * Tells if the view is provided by the reader.
+     *
+     * @return False if ReaderSpi::getPowerOnData must be used instead.
+     * @since 2.1.0
+     */
+    bool isValid() const
+    {
+        return mGeneration != 0;
+    }
+
+    /**
+     * Gets the first byte of the power-on data.
+     *
+     * @return Null if there is no power-on data.
+     * @since 2.1.0
+     */
+    const uint8_t* getData() const
+    {
+        return mData;
+    }
+
+    /**
+     * Gets the number of bytes of the power-on data.
+     *
+     * @return 0 if there is no power-on data (for example channel closed).
+     * @since 2.1.0
+     */
+    std::size_t getSize() const
+    {
+        return mSize;
+    }
+
+    /**
+     * Gets the generation number of the power-on data.
+     *
+     * @return A positive number, 0 if the view is not valid.
+     * @since 2.1.0
+     */
+    uint64_t getGeneration() const
+    {
+        return mGeneration;
+    }
+
+private:
+    /**
+     *
+     */
+    const uint8_t* mData;
+
+    /**
+     *
+     */
+    std::size_t mSize;
+
+    /**
+     *
+     */
+    uint64_t mGeneration;
+};
+
+}
+}
+}
+}
+}
@@ -12,19 +12,33 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
 
+/* Plugin */
+#include "BatchedApdu.h"
+#include "ParsedPowerOnData.h"
+#include "PowerOnDataView.h"
+#include "ReaderStatus.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+
 namespace keyple {
 namespace core {
 namespace plugin {
 namespace spi {
 namespace reader {
 
+using namespace keyple::core::util::cpp::exception;
+
 /**
  * Reader able to communicate with smart cards whose purpose is to remain present in the reader (for
  * example a SAM reader).
@@ -33,6 +47,22 @@ namespace reader {
  */
 class ReaderSpi {
 public:
+    /**
+     * Provider of the command data of {@link #transmitApduStreaming}: fills the buffer with the
+     * next chunk and returns its length, 0 once all the data has been provided.
+     *
+     * @since 2.1.0
+     */
+    using ApduChunkSource = std::function<std::size_t(uint8_t* buffer, std::size_t capacity)>;
+
+    /**
+     * Consumer of the response data of {@link #transmitApduStreaming}, invoked with each chunk in
+     * order as soon as it is received. The chunk is only valid during the call.
+     *
+     * @since 2.1.0
+     */
+    using ApduChunkSink = std::function<void(const uint8_t* data, std::size_t length)>;
+
     /**
      * 
      */
@@ -55,6 +85,29 @@ public:
      */
     virtual void openPhysicalChannel() = 0;
 
+    /**
+     * Attempts to open the physical channel, reporting a failure by the returned status instead of
+     * an exception.
+     *
+     * <p>The default implementation delegates to {@link #openPhysicalChannel()} and converts the
+     * exception, so it saves nothing on the error path. Plugins for which failures are frequent
+     * (for example a contactless card removed early) should implement it natively, and implement
+     * {@link #openPhysicalChannel()} with ReaderStatus::throwIfError.
+     *
+     * @return The outcome of the operation (READER_IO_ERROR or CARD_IO_ERROR on failure).
+     * @since 2.1.0
+     */
+    virtual ReaderStatus tryOpenPhysicalChannel() noexcept
+    {
+        try {
+            openPhysicalChannel();
+        } catch (...) {
+            return ReaderStatus::fromCurrentException();
+        }
+
+        return ReaderStatus();
+    }
+
     /**
      * Attempts to close the current physical channel.
      *
@@ -81,6 +134,28 @@ public:
      */
     virtual bool checkCardPresence() = 0;
 
+    /**
+     * Verifies the presence of a card, reporting a failure by the returned status instead of an
+     * exception.
+     *
+     * <p>The default implementation delegates to {@link #checkCardPresence()} and converts the
+     * exception. Plugins should implement it natively, as for {@link #tryOpenPhysicalChannel()}.
+     *
+     * @param isCardPresent Set to true if a card is present (left unchanged on failure).
+     * @return The outcome of the operation (READER_IO_ERROR on failure).
+     * @since 2.1.0
+     */
+    virtual ReaderStatus tryCheckCardPresence(bool& isCardPresent) noexcept
+    {
+        try {
+            isCardPresent = checkCardPresence();
+        } catch (...) {
+            return ReaderStatus::fromCurrentException();
+        }
+
+        return ReaderStatus();
+    }
+
     /**
      * Gets the power-on data.
      *
@@ -100,6 +175,51 @@ public:
      */
     virtual const std::string getPowerOnData() const = 0;
 
+    /**
+     * Gets the raw power-on data without copying it.
+     *
+     * <p>The returned view borrows storage owned by the reader, valid until the next invocation of
+     * {@link #openPhysicalChannel()} or {@link #closePhysicalChannel()}. Its generation number
+     * changes with the power-on data, allowing callers to cache the result of its parsing.
+     *
+     * <p>The default implementation returns an invalid view (see PowerOnDataView::isValid), in
+     * which case {@link #getPowerOnData()} must be used. See cpp::PowerOnDataCache to implement
+     * both methods from the same storage.
+     *
+     * @return A view of the power-on data, empty if the physical channel is not open.
+     * @since 2.1.0
+     */
+    virtual const PowerOnDataView getPowerOnDataView() const
+    {
+        return PowerOnDataView();
+    }
+
+    /**
+     * Gets the decoded power-on data (protocols, historical bytes, ATS fields, etc).
+     *
+     * <p>Plugins should compute it once when the physical channel is opened and return the same
+     * instance until it is closed, so that selection logic can inspect it at no cost. See
+     * cpp::PowerOnDataCache which does so.
+     *
+     * <p>The default implementation parses {@link #getPowerOnDataView()} if valid, {@link
+     * #getPowerOnData()} otherwise, at each invocation.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<const ParsedPowerOnData> getParsedPowerOnData() const
+    {
+        const PowerOnDataView view = getPowerOnDataView();
+
+        if (view.isValid()) {
+            return std::make_shared<const ParsedPowerOnData>(
+                       ParsedPowerOnData::parse(view.getData(), view.getSize()));
+        }
+
+        return std::make_shared<const ParsedPowerOnData>(
+                   ParsedPowerOnData::parse(getPowerOnData()));
+    }
+
     /**
      * Transmits an APDU and returns its response.
      *
@@ -114,6 +234,219 @@ public:
      */
     virtual const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) = 0;
 
+    /**
+     * Transmits an APDU provided as a raw buffer and writes its response into a buffer owned by the
+     * caller.
+     *
+     * <p>Unlike {@link #transmitApdu(const std::vector<uint8_t>&)}, this method does not impose
+     * any heap allocation: the caller can reuse the same output buffer for all the APDUs of a card
+     * transaction. A buffer of 258 bytes is enough for short APDUs, 65538 bytes for extended
+     * length ones.
+     *
+     * <p>The default implementation delegates to {@link #transmitApdu(const std::vector<uint8_t>&)}
+     * and copies the response, so that existing plugins remain compatible. Plugins able to
+     * exchange data with the reader without intermediate vectors should override it.
+     *
+     * <p><b>Caution: the implementation must handle the case where the card response is 61xy and
+     * execute the appropriate get response command.</b>
+     *
+     * <p>A buffer smaller than 2 bytes is rejected before anything is sent. Otherwise, the APDU is
+     * sent before the response length is known: if the response does not fit into the buffer, it
+     * is lost although the card has processed the command, and the exception reports the required
+     * length.
+     *
+     * @param apduIn The data to be sent to the card.
+     * @param apduInLength The number of bytes to send.
+     * @param apduOut The buffer receiving the card response.
+     * @param apduOutCapacity The size of the response buffer.
+     * @return The number of bytes written into apduOut (at least 2).
+     * @throw IllegalArgumentException If the buffer is smaller than 2 bytes or if the response
+     *        does not fit into it.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @throw CardIOException If the communication with the card has failed.
+     * @since 2.1.0
+     */
+    virtual std::size_t transmitApduInto(const uint8_t* apduIn,
+                                         const std::size_t apduInLength,
+                                         uint8_t* apduOut,
+                                         const std::size_t apduOutCapacity)
+    {
+        if (apduOutCapacity < 2) {
+            throw IllegalArgumentException("Response buffer too small: at least 2 bytes needed");
+        }
+
+        const std::vector<uint8_t> apduResponse =
+            transmitApdu(std::vector<uint8_t>(apduIn, apduIn + apduInLength));
+
+        if (apduResponse.size() > apduOutCapacity) {
+            throw IllegalArgumentException("Response buffer too small: " +
+                                           std::to_string(apduResponse.size()) +
+                                           " bytes needed");
+        }
+
+        std::copy(apduResponse.begin(), apduResponse.end(), apduOut);
+
+        return apduResponse.size();
+    }
+
+    /**
+     * Transmits an APDU like {@link #transmitApduInto(const uint8_t*, const std::size_t, uint8_t*,
+     * const std::size_t)}, reporting a failure by the returned status instead of an exception.
+     *
+     * <p>The default implementation delegates to {@link #transmitApduInto(const uint8_t*,
+     * const std::size_t, uint8_t*, const std::size_t)} and converts the exception. Plugins should
+     * implement it natively, as for {@link #tryOpenPhysicalChannel()}.
+     *
+     * <p><b>Caution: the implementation must handle the case where the card response is 61xy and
+     * execute the appropriate get response command.</b>
+     *
+     * @param apduIn The data to be sent to the card.
+     * @param apduInLength The number of bytes to send.
+     * @param apduOut The buffer receiving the card response.
+     * @param apduOutCapacity The size of the response buffer.
+     * @param apduOutLength Set to the number of bytes written into apduOut (left unchanged on
+     *        failure).
+     * @return The outcome of the operation (READER_IO_ERROR, CARD_IO_ERROR, or INVALID_ARGUMENT
+     *         if the response does not fit into the provided buffer).
+     * @since 2.1.0
+     */
+    virtual ReaderStatus tryTransmitApdu(const uint8_t* apduIn,
+                                         const std::size_t apduInLength,
+                                         uint8_t* apduOut,
+                                         const std::size_t apduOutCapacity,
+                                         std::size_t& apduOutLength) noexcept
+    {
+        try {
+            apduOutLength = transmitApduInto(apduIn, apduInLength, apduOut, apduOutCapacity);
+        } catch (...) {
+            return ReaderStatus::fromCurrentException();
+        }
+
+        return ReaderStatus();
+    }
+
+    /**
+     * Transmits an ordered list of APDUs and returns all their responses in a single call.
+     *
+     * <p>The transmission stops after the first response meeting the stop condition of its command
+     * (see BatchedApdu::isStopping), in which case fewer responses than commands are returned.
+     *
+     * <p>The default implementation invokes {@link #transmitApdu(const std::vector<uint8_t>&)}
+     * for each command. Plugins whose reader is able to pipeline or chain several commands in a
+     * single frame should override it to save the reader round trips.
+     *
+     * <p><b>Caution: the implementation must handle the case where a card response is 61xy and
+     * execute the appropriate get response command.</b>
+     *
+     * @param apdus The commands to be sent to the card, in order.
+     * @return The responses of the transmitted commands, in order.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @throw CardIOException If the communication with the card has failed.
+     * @since 2.1.0
+     */
+    virtual std::vector<std::vector<uint8_t>> transmitApdus(const std::vector<BatchedApdu>& apdus)
+    {
+        std::vector<std::vector<uint8_t>> apduResponses;
+        apduResponses.reserve(apdus.size());
+
+        for (const auto& apdu : apdus) {
+            apduResponses.push_back(transmitApdu(apdu.getApdu()));
+            if (apdu.isStopping(apduResponses.back())) {
+                break;
+            }
+        }
+
+        return apduResponses;
+    }
+
+    /**
+     * Transmits a command whose data and response may be larger than a single APDU, with constant
+     * memory: the command data is pulled from a source and the response data pushed to a sink
+     * chunk by chunk (for example for firmware loads or large record reads).
+     *
+     * <p>The plugin decides how the transfer is performed underneath (extended length APDU,
+     * command chaining, GET RESPONSE, etc). The response data is delivered to the sink before the
+     * whole response has been received when the reader permits it.
+     *
+     * <p>The default implementation uses ISO7816-4 command chaining (bit 5 of CLA set on all
+     * commands but the last, up to 255 data bytes each) through {@link
+     * #transmitApdu(const std::vector<uint8_t>&)}. The transfer stops at the first intermediate
+     * status word other than 9000, which is returned. The last command carries Le = 00 only if
+     * a response data sink is provided, and its response data is delivered as a single chunk.
+     * Plugins can override it to stream the GET RESPONSE fragments with
+     * cpp::ApduResponseChainer.
+     *
+     * @param cla The class byte.
+     * @param ins The instruction byte.
+     * @param p1 The first parameter byte.
+     * @param p2 The second parameter byte.
+     * @param commandData The source of the command data.
+     * @param responseData The sink of the response data (without status word), empty if no
+     *        response data is expected (ISO7816-4 case 1 or 3 command, sent without Le).
+     * @return The final status word.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @throw CardIOException If the communication with the card has failed.
+     * @since 2.1.0
+     */
+    virtual int transmitApduStreaming(const uint8_t cla,
+                                      const uint8_t ins,
+                                      const uint8_t p1,
+                                      const uint8_t p2,
+                                      const ApduChunkSource& commandData,
+                                      const ApduChunkSink& responseData)
+    {
+        static const std::size_t HEADER_LENGTH = 5;
+        static const std::size_t MAX_CHUNK_LENGTH = 255;
+
+        /* Two command buffers, the next chunk being read ahead to know which one is the last */
+        std::vector<uint8_t> command(HEADER_LENGTH + MAX_CHUNK_LENGTH + 1);
+        std::vector<uint8_t> nextCommand(HEADER_LENGTH + MAX_CHUNK_LENGTH + 1);
+
+        std::size_t chunkLength = commandData(&command[HEADER_LENGTH], MAX_CHUNK_LENGTH);
+
+        while (true) {
+            const std::size_t nextChunkLength =
+                chunkLength == 0 ? 0
+                                 : commandData(&nextCommand[HEADER_LENGTH], MAX_CHUNK_LENGTH);
+            const bool isLast = nextChunkLength == 0;
+
+            command[0] = isLast ? cla : static_cast<uint8_t>(cla | 0x10);
+            command[1] = ins;
+            command[2] = p1;
+            command[3] = p2;
+
+            std::size_t commandLength = 4;
+            if (chunkLength != 0) {
+                command[4] = static_cast<uint8_t>(chunkLength);
+                commandLength = HEADER_LENGTH + chunkLength;
+            }
+            if (isLast && responseData) {
+                /* Le = 00: up to 256 bytes expected */
+                command[commandLength++] = 0x00;
+            }
+
+            const std::vector<uint8_t> apduResponse = transmitApdu(
+                std::vector<uint8_t>(command.begin(), command.begin() + commandLength));
+
+            const std::size_t dataLength = apduResponse.size() - 2;
+            const int statusWord = (apduResponse[dataLength] << 8) | apduResponse[dataLength + 1];
+
+            if (isLast) {
+                if (dataLength != 0 && responseData) {
+                    responseData(apduResponse.data(), dataLength);
+                }
+                return statusWord;
+            }
+
+            if (statusWord != 0x9000) {
+                return statusWord;
+            }
+
+            command.swap(nextCommand);
+            chunkLength = nextChunkLength;
+        }
+    }
+
     /**
      * Tells if the reader is a contactless type.
      *
@@ -0,0 +1,193 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+
+/* Plugin */
+#include "CardIOException.h"
+#include "ReaderIOException.h"
+#include "StaticMessage.h"
+
+/* Util */
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Outcome of the exception-free I/O methods of ReaderSpi (for example
+ * ReaderSpi::tryTransmitApdu).
+ *
+ * <p>A status is made of a code, of a reason referencing a string literal (see StaticMessage) and
+ * of an optional plugin-specific error code, so that it can be created, copied and returned
+ * without allocating.
+ *
+ * @since 2.1.0
+ */
+class ReaderStatus final {
+public:
+    /**
+     * Category of the outcome, matching the exception raised by the throwing methods.
+     *
+     * @since 2.1.0
+     */
+    enum class Code : uint8_t {
+        /** The operation has succeeded. */
+        OK = 0,
+        /** The communication with the reader has failed (ReaderIOException). */
+        READER_IO_ERROR = 1,
+        /** The communication with the card has failed (CardIOException). */
+        CARD_IO_ERROR = 2,
+        /** An argument is invalid, for example a too small buffer (IllegalArgumentException). */
+        INVALID_ARGUMENT = 3,
+        /** An exception of any other type has been raised; its type and message are lost. */
+        UNEXPECTED_ERROR = 4
+    };
+
+    /**
+     * Creates a successful status.
+     *
+     * @since 2.1.0
+     */
+    ReaderStatus() noexcept : mCode(Code::OK), mReason(""), mErrorCode(0) {}
+
+    /**
+     * @param code The category of the outcome.
+     * @param reason A string literal.
+     * @param errorCode The plugin-specific error code (for example the status of the native
+     *     driver), 0 if none.
+     * @since 2.1.0
+     */
+    ReaderStatus(const Code code, const StaticMessage& reason, const int errorCode = 0) noexcept
+    : mCode(code), mReason(reason), mErrorCode(errorCode) {}
+
+    /**
+     * @return True if the operation has succeeded.
+     * @since 2.1.0
+     */
+    bool isOk() const noexcept
+    {
+        return mCode == Code::OK;
+    }
+
+    /**
+     * @return The category of the outcome.
+     * @since 2.1.0
+     */
+    Code getCode() const noexcept
+    {
+        return mCode;
+    }
+
+    /**
+     * @return A not null string, empty if the operation has succeeded.
+     * @since 2.1.0
+     */
+    const char* getReason() const noexcept
+    {
+        return mReason.get();
+    }
+
+    /**
+     * @return The plugin-specific error code, 0 if none.
+     * @since 2.1.0
+     */
+    int getErrorCode() const noexcept
+    {
+        return mErrorCode;
+    }
+
+    /**
+     * Raises the exception matching the code, with the reason as message, unless the operation
+     * has succeeded. I/O exceptions are created without allocating and carry the plugin-specific
+     * error code.
+     *
+     * <p>Lets plugins implement the throwing methods of ReaderSpi on top of their native
+     * exception-free ones. Since the original exception of an UNEXPECTED_ERROR cannot be
+     * restored, it is reported as a ReaderIOException, the failure the throwing methods declare.
+     *
+     * @throw ReaderIOException If the code is READER_IO_ERROR or UNEXPECTED_ERROR.
+     * @throw CardIOException If the code is CARD_IO_ERROR.
+     * @throw IllegalArgumentException If the code is INVALID_ARGUMENT.
+     * @since 2.1.0
+     */
+    void throwIfError() const
+    {
+        switch (mCode) {
+        case Code::OK:
+            return;
+        case Code::CARD_IO_ERROR:
+            throw CardIOException(mErrorCode, mReason);
+        case Code::INVALID_ARGUMENT:
+            throw IllegalArgumentException(mReason.get());
+        default:
+            throw ReaderIOException(mErrorCode, mReason);
+        }
+    }
+
+    /**
+     * Converts the exception being handled into a status.
+     *
+     * <p>Must be invoked from a catch block. The mapping is lossy: the message of the exception
+     * is not kept, the reason only describes its category, and only the error code of the I/O
+     * exceptions is kept. Exceptions of any other type, including std::exception, are all mapped
+     * to UNEXPECTED_ERROR.
+     *
+     * @return A not successful status.
+     * @since 2.1.0
+     */
+    static ReaderStatus fromCurrentException() noexcept
+    {
+        try {
+            throw;
+        } catch (const CardIOException& e) {
+            return ReaderStatus(
+                Code::CARD_IO_ERROR, "Communication with the card failed", e.getCode());
+        } catch (const ReaderIOException& e) {
+            return ReaderStatus(
+                Code::READER_IO_ERROR, "Communication with the reader failed", e.getCode());
+        } catch (const IllegalArgumentException&) {
+            return ReaderStatus(Code::INVALID_ARGUMENT, "Invalid argument");
+        } catch (...) {
+            return ReaderStatus(Code::UNEXPECTED_ERROR, "Unexpected reader error");
+        }
+    }
+
+private:
+    /**
+     *
+     */
+    Code mCode;
+
+    /**
+     *
+     */
+    StaticMessage mReason;
+
+    /**
+     *
+     */
+    int mErrorCode;
+};
+
+}
+}
+}
+}
+}
@@ -0,0 +1,81 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+namespace observable {
+
+/**
+ * Observable reader able to signal through a native waitable handle that its card presence may
+ * have changed, so that a single thread can observe many readers at once (for example with
+ * cpp::ReadinessMultiplexer) instead of blocking a thread in the wait of each reader.
+ *
+ * <p>The handle is level-triggered: it becomes ready when a card may have been inserted or
+ * removed, and stays ready until {@link #acknowledgeReadiness()} is invoked. The observer then
+ * invokes ReaderSpi::checkCardPresence to get the actual state. cpp::ReadinessEvent provides a
+ * ready-to-use handle.
+ *
+ * <p>This interface complements the card insertion and removal observation interfaces (see
+ * {@link ObservableReaderSpi}), which the reader must still implement for the observers not
+ * supporting multiplexing.
+ *
+ * @since 2.1.0
+ */
+class MultiplexedObservationSpi {
+public:
+#if defined(_WIN32)
+    /**
+     * Handle of a Win32 event object, signaled when ready.
+     *
+     * @since 2.1.0
+     */
+    using ReadinessHandle = void*;
+#else
+    /**
+     * File descriptor, readable when ready.
+     *
+     * @since 2.1.0
+     */
+    using ReadinessHandle = int;
+#endif
+
+    /**
+     *
+     */
+    virtual ~MultiplexedObservationSpi() = default;
+
+    /**
+     * Gets the readiness handle, owned by the reader and valid until it is unregistered.
+     *
+     * @return A valid handle.
+     * @since 2.1.0
+     */
+    virtual ReadinessHandle getReadinessHandle() const = 0;
+
+    /**
+     * Resets the readiness handle, before checking the card presence.
+     *
+     * @since 2.1.0
+     */
+    virtual void acknowledgeReadiness() = 0;
+};
+
+}
+}
+}
+}
+}
+}
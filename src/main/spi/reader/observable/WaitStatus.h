@@ -0,0 +1,86 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+#pragma once
+
+#include <chrono>
+
+namespace keyple {
+namespace core {
+namespace plugin {
+namespace spi {
+namespace reader {
+namespace observable {
+
+/**
+ * Outcome of a deadline-aware blocking wait (for example
+ * state::insertion::WaitForCardInsertionBlockingSpi::waitForCardInsertionUntil).
+ *
+ * @since 2.1.0
+ */
+enum class WaitStatus {
+    /**
+     * The awaited event occurred.
+     *
+     * @since 2.1.0
+     */
+    COMPLETED,
+
+    /**
+     * The deadline was reached first.
+     *
+     * @since 2.1.0
+     */
+    TIMED_OUT,
+
+    /**
+     * The wait was stopped.
+     *
+     * @since 2.1.0
+     */
+    CANCELED
+};
+
+/**
+ * Maximum time in milliseconds between the invocation of a stop method and the return of the
+ * deadline-aware wait it interrupts, for the implementations overriding the default ones.
+ *
+ * @since 2.1.0
+ */
+enum : int {
+    MAX_STOP_LATENCY_MILLIS = 100
+};
+
+/**
+ * Gets the deadline of a wait starting now and lasting the provided duration, saturated to
+ * time_point::max() (i.e. no deadline) when it cannot be represented.
+ *
+ * @param timeout The maximum waiting time.
+ * @return The deadline.
+ * @since 2.1.0
+ */
+inline std::chrono::steady_clock::time_point getDeadline(const std::chrono::milliseconds& timeout)
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (timeout >= std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::time_point::max() - now)) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+
+    return now + timeout;
+}
+
+}
+}
+}
+}
+}
+}
@@ -12,6 +12,12 @@
 
 #pragma once
 
+#include <chrono>
+
+/* Plugin */
+#include "TaskCanceledException.h"
+#include "WaitStatus.h"
+
 namespace keyple {
 namespace core {
 namespace plugin {
@@ -21,6 +27,8 @@ namespace observable {
 namespace state {
 namespace insertion {
 
+using namespace keyple::core::plugin;
+
 /**
  * Reader able to wait autonomously and indefinitely for the insertion of a card by implementing a
  * waiting mechanism.
@@ -45,6 +53,67 @@ public:
      */
     virtual void waitForCardInsertion() = 0;
 
+    /**
+     * Waits for a card to be inserted, until the provided deadline at most.
+     *
+     * <p>Unlike {@link #waitForCardInsertion()}, timing out and being stopped are reported by the
+     * returned status instead of an exception. Implementations overriding this method must honor
+     * the deadline and return CANCELED at most MAX_STOP_LATENCY_MILLIS after the invocation of
+     * {@link #stopWaitForCardInsertion()}.
+     *
+     * <p>The default implementation delegates to {@link #waitForCardInsertion()}, mapping
+     * TaskCanceledException to CANCELED: it neither honors the deadline nor bounds the stop
+     * latency, and never returns TIMED_OUT.
+     *
+     * <p>Callers can check whether the deadline is honored with
+     * {@link #isCardInsertionDeadlineSupported()}.
+     *
+     * @param deadline The point in time after which the wait gives up.
+     * @return The outcome of the wait.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @since 2.1.0
+     */
+    virtual WaitStatus waitForCardInsertionUntil(
+        const std::chrono::steady_clock::time_point& deadline)
+    {
+        (void)deadline;
+
+        try {
+            waitForCardInsertion();
+        } catch (const TaskCanceledException&) {
+            return WaitStatus::CANCELED;
+        }
+
+        return WaitStatus::COMPLETED;
+    }
+
+    /**
+     * Indicates whether the deadline-aware wait honors the deadline and bounds the stop latency,
+     * i.e. whether {@link #waitForCardInsertionUntil()} is overridden.
+     *
+     * @return False for the default implementation.
+     * @since 2.1.0
+     */
+    virtual bool isCardInsertionDeadlineSupported() const
+    {
+        return false;
+    }
+
+    /**
+     * Waits for a card to be inserted during the provided duration at most.
+     *
+     * @param timeout The maximum waiting time, infinite if too large to be represented as a
+     *     deadline.
+     * @return The outcome of the wait.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @see #waitForCardInsertionUntil(const std::chrono::steady_clock::time_point&)
+     * @since 2.1.0
+     */
+    WaitStatus waitForCardInsertionFor(const std::chrono::milliseconds& timeout)
+    {
+        return waitForCardInsertionUntil(getDeadline(timeout));
+    }
+
     /**
      * Interrupts the waiting of a card insertion.
      *
@@ -12,6 +12,12 @@
 
 #pragma once
 
+#include <chrono>
+
+/* Plugin */
+#include "TaskCanceledException.h"
+#include "WaitStatus.h"
+
 namespace keyple {
 namespace core {
 namespace plugin {
@@ -21,6 +27,8 @@ namespace observable {
 namespace state {
 namespace processing {
 
+using namespace keyple::core::plugin;
+
 /**
  * Reader able to detect a card removal during processing, between two APDU commands.
  *
@@ -48,6 +56,67 @@ public:
      */
     virtual void waitForCardRemovalDuringProcessing() = 0;
 
+    /**
+     * Waits for a card to be removed, until the provided deadline at most.
+     *
+     * <p>Unlike {@link #waitForCardRemovalDuringProcessing()}, timing out and being stopped are
+     * reported by the returned status instead of an exception. Implementations overriding this
+     * method must honor the deadline and return CANCELED at most MAX_STOP_LATENCY_MILLIS after the
+     * invocation of {@link #stopWaitForCardRemovalDuringProcessing()}.
+     *
+     * <p>The default implementation delegates to {@link #waitForCardRemovalDuringProcessing()},
+     * mapping TaskCanceledException to CANCELED: it neither honors the deadline nor bounds the
+     * stop latency, and never returns TIMED_OUT.
+     *
+     * <p>Callers can check whether the deadline is honored with
+     * {@link #isCardRemovalDuringProcessingDeadlineSupported()}.
+     *
+     * @param deadline The point in time after which the wait gives up.
+     * @return The outcome of the wait.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @since 2.1.0
+     */
+    virtual WaitStatus waitForCardRemovalDuringProcessingUntil(
+        const std::chrono::steady_clock::time_point& deadline)
+    {
+        (void)deadline;
+
+        try {
+            waitForCardRemovalDuringProcessing();
+        } catch (const TaskCanceledException&) {
+            return WaitStatus::CANCELED;
+        }
+
+        return WaitStatus::COMPLETED;
+    }
+
+    /**
+     * Indicates whether the deadline-aware wait honors the deadline and bounds the stop latency,
+     * i.e. whether {@link #waitForCardRemovalDuringProcessingUntil()} is overridden.
+     *
+     * @return False for the default implementation.
+     * @since 2.1.0
+     */
+    virtual bool isCardRemovalDuringProcessingDeadlineSupported() const
+    {
+        return false;
+    }
+
+    /**
+     * Waits for a card to be removed during the provided duration at most.
+     *
+     * @param timeout The maximum waiting time, infinite if too large to be represented as a
+     *     deadline.
+     * @return The outcome of the wait.
+     * @throw ReaderIOException If the communication with the reader has failed.
+     * @see #waitForCardRemovalDuringProcessingUntil(const std::chrono::steady_clock::time_point&)
+     * @since 2.1.0
+     */
+    WaitStatus waitForCardRemovalDuringProcessingFor(const std::chrono::milliseconds& timeout)
+    {
+        return waitForCardRemovalDuringProcessingUntil(getDeadline(timeout));
+    }
+
     /**
      * Interrupts the waiting of the removal of the card
      *
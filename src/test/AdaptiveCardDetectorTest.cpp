@@ -0,0 +1,167 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "AdaptiveCardDetector.h"
+#include "ReaderIOException.h"
+#include "TaskCanceledException.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+using namespace keyple::core::plugin::spi::reader::observable;
+
+TEST(AdaptiveCardDetectorTest, constructor_whenIntervalsAreNotOrdered_shouldThrowIAE)
+{
+    EXPECT_THROW(AdaptiveCardDetector([] { return true; },
+                                      std::chrono::milliseconds(10),
+                                      std::chrono::milliseconds(5)),
+                 IllegalArgumentException);
+}
+
+TEST(AdaptiveCardDetectorTest, waitForCardInsertion_shouldReturnOnceCardIsPresent)
+{
+    std::atomic<bool> isCardPresent(false);
+    AdaptiveCardDetector detector([&isCardPresent] { return isCardPresent.load(); },
+                                  std::chrono::milliseconds(1),
+                                  std::chrono::milliseconds(10));
+
+    std::thread inserter([&isCardPresent] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        isCardPresent = true;
+    });
+    detector.waitForCardInsertion();
+    inserter.join();
+
+    ASSERT_GT(detector.getPollCount(), 1u);
+    ASSERT_EQ(detector.getDetectionLatencies().getCount(), 1u);
+}
+
+TEST(AdaptiveCardDetectorTest, waitForCardInsertion_whenCardIsAlreadyPresent_shouldNotWait)
+{
+    AdaptiveCardDetector detector([] { return true; });
+
+    detector.waitForCardInsertion();
+
+    ASSERT_EQ(detector.getPollCount(), 1u);
+    ASSERT_EQ(detector.getDetectionLatencies().getCount(), 0u);
+}
+
+TEST(AdaptiveCardDetectorTest, waitForCardInsertion_whenIdle_shouldBackOff)
+{
+    std::atomic<bool> isCardPresent(false);
+    AdaptiveCardDetector detector([&isCardPresent] { return isCardPresent.load(); },
+                                  std::chrono::milliseconds(1),
+                                  std::chrono::milliseconds(16),
+                                  std::chrono::milliseconds(0));
+
+    std::thread inserter([&isCardPresent] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        isCardPresent = true;
+    });
+    detector.waitForCardInsertion();
+    inserter.join();
+
+    /* 1 + 2 + 4 + 8 ms, then every 16 ms: about 12 polls instead of 100 at the minimum rate */
+    ASSERT_LT(detector.getPollCount(), 20u);
+    ASSERT_EQ(detector.getPollingInterval(), std::chrono::milliseconds(16));
+
+    detector.signalActivity();
+    ASSERT_EQ(detector.getPollingInterval(), std::chrono::milliseconds(1));
+}
+
+TEST(AdaptiveCardDetectorTest, waitForCardRemoval_shouldSwitchToFastPolling)
+{
+    std::atomic<bool> isCardPresent(true);
+    AdaptiveCardDetector detector([&isCardPresent] { return isCardPresent.load(); },
+                                  std::chrono::milliseconds(1),
+                                  std::chrono::milliseconds(8),
+                                  std::chrono::milliseconds(0));
+
+    std::thread remover([&isCardPresent] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        isCardPresent = false;
+    });
+    detector.waitForCardRemoval();
+    remover.join();
+
+    ASSERT_EQ(detector.getPollingInterval(), std::chrono::milliseconds(1));
+}
+
+TEST(AdaptiveCardDetectorTest, stop_shouldThrowTCE)
+{
+    AdaptiveCardDetector detector([] { return false; });
+
+    std::thread stopper([&detector] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        detector.stop();
+    });
+    EXPECT_THROW(detector.waitForCardInsertion(), TaskCanceledException);
+    stopper.join();
+}
+
+TEST(AdaptiveCardDetectorTest, stop_whenCalledBeforeWait_shouldCancelNextWaitOnly)
+{
+    AdaptiveCardDetector detector([] { return false; });
+
+    detector.stop();
+    ASSERT_EQ(detector.waitForCardInsertionUntil(std::chrono::steady_clock::now() +
+                                                 std::chrono::seconds(10)),
+              WaitStatus::CANCELED);
+    ASSERT_EQ(detector.getPollCount(), 0u);
+
+    ASSERT_EQ(detector.waitForCardInsertionUntil(std::chrono::steady_clock::now()),
+              WaitStatus::TIMED_OUT);
+}
+
+TEST(AdaptiveCardDetectorTest, waitForCardInsertionUntil_whenNoCard_shouldTimeOut)
+{
+    AdaptiveCardDetector detector([] { return false; },
+                                  std::chrono::milliseconds(1),
+                                  std::chrono::milliseconds(1000));
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ASSERT_EQ(detector.waitForCardInsertionUntil(start + std::chrono::milliseconds(20)),
+              WaitStatus::TIMED_OUT);
+
+    /* The deadline bounds the polling interval */
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
+
+TEST(AdaptiveCardDetectorTest, stop_shouldCancelWaitUntil)
+{
+    AdaptiveCardDetector detector([] { return true; });
+
+    std::thread stopper([&detector] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        detector.stop();
+    });
+    ASSERT_EQ(detector.waitForCardRemovalUntil(std::chrono::steady_clock::now() +
+                                               std::chrono::seconds(10)),
+              WaitStatus::CANCELED);
+    stopper.join();
+}
+
+TEST(AdaptiveCardDetectorTest, waitForCardInsertion_whenProbeFails_shouldPropagate)
+{
+    AdaptiveCardDetector detector([]() -> bool { throw ReaderIOException("Reader removed"); });
+
+    EXPECT_THROW(detector.waitForCardInsertion(), ReaderIOException);
+}
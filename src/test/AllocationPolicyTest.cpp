@@ -0,0 +1,84 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "LeastRecentlyUsedAllocationPolicy.h"
+#include "LowestLatencyAllocationPolicy.h"
+#include "RoundRobinAllocationPolicy.h"
+#include "StickyAffinityAllocationPolicy.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::cpp;
+
+static std::vector<std::shared_ptr<ReaderSpi>> createReaders(const std::size_t count)
+{
+    std::vector<std::shared_ptr<ReaderSpi>> readers;
+    for (std::size_t i = 0; i < count; i++) {
+        auto reader = std::make_shared<NiceMock<ReaderSpiMock>>();
+        ON_CALL(*reader, getName()).WillByDefault(ReturnRefOfCopy("READER_" + std::to_string(i)));
+        readers.push_back(reader);
+    }
+
+    return readers;
+}
+
+TEST(AllocationPolicyTest, roundRobin_shouldCycleThroughReaders)
+{
+    const auto readers = createReaders(3);
+    RoundRobinAllocationPolicy policy;
+
+    ASSERT_EQ(policy.selectReader(readers, ""), 0u);
+    ASSERT_EQ(policy.selectReader(readers, ""), 1u);
+    ASSERT_EQ(policy.selectReader(readers, ""), 2u);
+    ASSERT_EQ(policy.selectReader(readers, ""), 0u);
+}
+
+TEST(AllocationPolicyTest, leastRecentlyUsed_shouldSelectOldestAllocation)
+{
+    const auto readers = createReaders(3);
+    LeastRecentlyUsedAllocationPolicy policy;
+    policy.onReaderAllocated(readers[0], "");
+    policy.onReaderAllocated(readers[2], "");
+    policy.onReaderAllocated(readers[1], "");
+    policy.onReaderAllocated(readers[0], "");
+
+    ASSERT_EQ(policy.selectReader(readers, ""), 2u);
+}
+
+TEST(AllocationPolicyTest, stickyAffinity_whenPreferredReaderIsFree_shouldSelectIt)
+{
+    const auto readers = createReaders(3);
+    StickyAffinityAllocationPolicy policy;
+    policy.onReaderAllocated(readers[1], "CARD_A");
+
+    ASSERT_EQ(policy.selectReader(readers, "CARD_A"), 1u);
+
+    const std::vector<std::shared_ptr<ReaderSpi>> otherReaders = {readers[0], readers[2]};
+    ASSERT_EQ(policy.selectReader(otherReaders, "CARD_A"), 0u);
+}
+
+TEST(AllocationPolicyTest, lowestLatency_shouldSelectFastestReader)
+{
+    const auto readers = createReaders(2);
+    LowestLatencyAllocationPolicy policy;
+    policy.onLatencyMeasured(readers[0], std::chrono::milliseconds(5));
+    policy.onLatencyMeasured(readers[1], std::chrono::milliseconds(2));
+
+    ASSERT_EQ(policy.selectReader(readers, ""), 1u);
+}
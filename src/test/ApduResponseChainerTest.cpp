@@ -0,0 +1,133 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstring>
+#include <deque>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ApduResponseChainer.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::cpp;
+
+/**
+ * Card answering the scripted responses in order and recording the received commands.
+ */
+class ScriptedCard {
+public:
+    std::deque<std::vector<uint8_t>> mResponses;
+    std::vector<std::vector<uint8_t>> mCommands;
+
+    ApduResponseChainer::RawTransmitter getTransmitter()
+    {
+        return [this](const uint8_t* apduIn,
+                      std::size_t apduInLength,
+                      uint8_t* apduOut,
+                      std::size_t apduOutCapacity) {
+            mCommands.push_back(std::vector<uint8_t>(apduIn, apduIn + apduInLength));
+            const std::vector<uint8_t> response = mResponses.front();
+            mResponses.pop_front();
+            if (response.size() > apduOutCapacity) {
+                throw IllegalArgumentException("Response buffer too small");
+            }
+            std::memcpy(apduOut, response.data(), response.size());
+            return response.size();
+        };
+    }
+};
+
+TEST(ApduResponseChainerTest, transmit_when61xx_shouldConcatenateFragments)
+{
+    ScriptedCard card;
+    card.mResponses = {{0x01, 0x02, 0x61, 0x03},
+                       {0x03, 0x04, 0x05, 0x61, 0x01},
+                       {0x06, 0x90, 0x00}};
+    ApduResponseChainer chainer(card.getTransmitter());
+
+    const std::vector<uint8_t> response = chainer.transmit({0x00, 0xB2, 0x01, 0x04, 0x00});
+
+    ASSERT_THAT(response, ElementsAre(0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x90, 0x00));
+    ASSERT_THAT(card.mCommands[1], ElementsAre(0x00, 0xC0, 0x00, 0x00, 0x03));
+    ASSERT_THAT(card.mCommands[2], ElementsAre(0x00, 0xC0, 0x00, 0x00, 0x01));
+}
+
+TEST(ApduResponseChainerTest, transmit_when6Cxx_shouldReissueWithLe)
+{
+    ScriptedCard card;
+    card.mResponses = {{0x6C, 0x02}, {0xAA, 0xBB, 0x90, 0x00}};
+    ApduResponseChainer chainer(card.getTransmitter());
+
+    const std::vector<uint8_t> response = chainer.transmit({0x00, 0xCA, 0x9F, 0x7F, 0x00});
+
+    ASSERT_THAT(response, ElementsAre(0xAA, 0xBB, 0x90, 0x00));
+    ASSERT_THAT(card.mCommands[1], ElementsAre(0x00, 0xCA, 0x9F, 0x7F, 0x02));
+}
+
+TEST(ApduResponseChainerTest, transmit_when6CxxOnCase3_shouldAppendLe)
+{
+    ScriptedCard card;
+    card.mResponses = {{0x6C, 0x10}, {0x90, 0x00}};
+    ApduResponseChainer chainer(card.getTransmitter());
+
+    chainer.transmit({0x00, 0xA4, 0x04, 0x00, 0x02, 0x3F, 0x00});
+
+    ASSERT_THAT(card.mCommands[1], ElementsAre(0x00, 0xA4, 0x04, 0x00, 0x02, 0x3F, 0x00, 0x10));
+}
+
+TEST(ApduResponseChainerTest, transmit_whenResponseDoesNotFit_shouldThrowIAE)
+{
+    ScriptedCard card;
+    card.mResponses = {{0x01, 0x02, 0x61, 0x02}, {0x03, 0x04, 0x90, 0x00}};
+    ApduResponseChainer chainer(card.getTransmitter());
+
+    const uint8_t apduIn[] = {0x00, 0xB0, 0x00, 0x00, 0x00};
+    uint8_t apduOut[4];
+
+    EXPECT_THROW(chainer.transmit(apduIn, sizeof(apduIn), apduOut, sizeof(apduOut)),
+                 IllegalArgumentException);
+}
+
+TEST(ApduResponseChainerTest, transmit_withSink_shouldStreamFragments)
+{
+    ScriptedCard card;
+    card.mResponses = {{0x01, 0x02, 0x61, 0x01}, {0x03, 0x62, 0x83}};
+    ApduResponseChainer chainer(card.getTransmitter());
+
+    const uint8_t apduIn[] = {0x00, 0xB0, 0x00, 0x00, 0x00};
+    std::vector<std::vector<uint8_t>> fragments;
+
+    const int statusWord = chainer.transmit(
+        apduIn, sizeof(apduIn), [&fragments](const uint8_t* data, std::size_t length) {
+            fragments.push_back(std::vector<uint8_t>(data, data + length));
+        });
+
+    ASSERT_EQ(statusWord, 0x6283);
+    ASSERT_EQ(fragments.size(), 2u);
+    ASSERT_THAT(fragments[0], ElementsAre(0x01, 0x02));
+    ASSERT_THAT(fragments[1], ElementsAre(0x03));
+}
+
+TEST(ApduResponseChainerTest, transmit_withEmptySink_shouldDropResponseData)
+{
+    ScriptedCard card;
+    card.mResponses = {{0x01, 0x02, 0x61, 0x01}, {0x03, 0x90, 0x00}};
+    ApduResponseChainer chainer(card.getTransmitter());
+
+    const uint8_t apduIn[] = {0x00, 0xB0, 0x00, 0x00, 0x00};
+
+    ASSERT_EQ(chainer.transmit(apduIn, sizeof(apduIn), ReaderSpi::ApduChunkSink()), 0x9000);
+    ASSERT_EQ(card.mCommands.size(), 2u);
+}
@@ -0,0 +1,205 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ApduTraceDecoder.h"
+#include "CardIOException.h"
+#include "TracingReaderSpi.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+
+static const std::string READER_NAME = "READER_1";
+static const std::vector<uint8_t> APDU = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> RESP = {0x12, 0x34, 0x90, 0x00};
+
+TEST(ApduTraceTest, tracingReaderSpi_shouldRecordCardSession)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, openPhysicalChannel()).Times(1);
+    EXPECT_CALL(*reader, getPowerOnData()).WillOnce(Return("3B8F8001"));
+    EXPECT_CALL(*reader, transmitApdu(APDU)).WillOnce(Return(RESP));
+    EXPECT_CALL(*reader, closePhysicalChannel()).Times(1);
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+
+    tracing.openPhysicalChannel();
+    ASSERT_EQ(tracing.transmitApdu(APDU), RESP);
+    tracing.closePhysicalChannel();
+
+    const ApduTraceDecoder decoder(traceBuffer->serialize());
+    ASSERT_EQ(decoder.getReaderName(), READER_NAME);
+    ASSERT_EQ(decoder.getDroppedRecordCount(), 0u);
+    ASSERT_NE(decoder.getStartTime(), 0u);
+
+    const std::vector<ApduTraceRecord>& records = decoder.getRecords();
+    ASSERT_EQ(records.size(), 4u);
+    ASSERT_EQ(records[0].getType(), ApduTraceRecord::Type::CHANNEL_OPENED);
+    ASSERT_EQ(records[0].getPayload(), std::vector<uint8_t>({0x3B, 0x8F, 0x80, 0x01}));
+    ASSERT_EQ(records[1].getType(), ApduTraceRecord::Type::COMMAND);
+    ASSERT_EQ(records[1].getPayload(), APDU);
+    ASSERT_EQ(records[2].getType(), ApduTraceRecord::Type::RESPONSE);
+    ASSERT_EQ(records[2].getPayload(), RESP);
+    ASSERT_EQ(records[3].getType(), ApduTraceRecord::Type::CHANNEL_CLOSED);
+    ASSERT_LE(records[1].getTimestamp(), records[2].getTimestamp());
+}
+
+TEST(ApduTraceTest, tracingReaderSpi_whenFailing_shouldRecordError)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(APDU)).WillOnce(Throw(CardIOException("Card removed")));
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+
+    EXPECT_THROW(tracing.transmitApdu(APDU), CardIOException);
+
+    const ApduTraceDecoder decoder(traceBuffer->serialize());
+    const std::vector<ApduTraceRecord>& records = decoder.getRecords();
+    ASSERT_EQ(records.size(), 2u);
+    ASSERT_EQ(records[1].getType(), ApduTraceRecord::Type::ERROR);
+    ASSERT_EQ(records[1].getPayload()[0],
+              static_cast<uint8_t>(ApduTraceRecord::ErrorCategory::CARD_IO));
+    ASSERT_EQ(std::string(records[1].getPayload().begin() + 1, records[1].getPayload().end()),
+              "Card removed");
+}
+
+TEST(ApduTraceTest, tracingReaderSpi_whenBatchFails_shouldRecordCommandsSentBefore)
+{
+    const std::vector<uint8_t> failingApdu = {0x00, 0xB2, 0x02, 0x04, 0x00};
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(APDU)).WillOnce(Return(RESP));
+    EXPECT_CALL(*reader, transmitApdu(failingApdu))
+        .WillOnce(Throw(CardIOException("Card removed")));
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+
+    EXPECT_THROW(tracing.transmitApdus({BatchedApdu(APDU), BatchedApdu(failingApdu)}),
+                 CardIOException);
+
+    const ApduTraceDecoder decoder(traceBuffer->serialize());
+    const std::vector<ApduTraceRecord>& records = decoder.getRecords();
+    ASSERT_EQ(records.size(), 4u);
+    ASSERT_EQ(records[0].getType(), ApduTraceRecord::Type::COMMAND);
+    ASSERT_EQ(records[0].getPayload(), APDU);
+    ASSERT_EQ(records[1].getType(), ApduTraceRecord::Type::RESPONSE);
+    ASSERT_EQ(records[1].getPayload(), RESP);
+    ASSERT_EQ(records[2].getType(), ApduTraceRecord::Type::COMMAND);
+    ASSERT_EQ(records[2].getPayload(), failingApdu);
+    ASSERT_EQ(records[3].getType(), ApduTraceRecord::Type::ERROR);
+}
+
+TEST(ApduTraceTest, tracingReaderSpi_whenStreaming_shouldRecordEachChunk)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(_)).Times(2).WillRepeatedly(Return(RESP));
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+
+    std::size_t remaining = 300;
+    const int statusWord = tracing.transmitApduStreaming(
+        0x80, 0xD6, 0x00, 0x00,
+        [&remaining](uint8_t* buffer, std::size_t capacity) {
+            const std::size_t length = std::min(remaining, capacity);
+            std::fill(buffer, buffer + length, 0xAB);
+            remaining -= length;
+            return length;
+        },
+        [](const uint8_t*, std::size_t) {});
+    ASSERT_EQ(statusWord, 0x9000);
+
+    const ApduTraceDecoder decoder(traceBuffer->serialize());
+    const std::vector<ApduTraceRecord>& records = decoder.getRecords();
+    ASSERT_EQ(records.size(), 5u);
+    ASSERT_EQ(records[0].getType(), ApduTraceRecord::Type::STREAM_STARTED);
+    ASSERT_EQ(records[0].getPayload(), std::vector<uint8_t>({0x80, 0xD6, 0x00, 0x00}));
+    ASSERT_EQ(records[1].getType(), ApduTraceRecord::Type::COMMAND_CHUNK);
+    ASSERT_EQ(records[1].getPayload().size(), 255u);
+    ASSERT_EQ(records[2].getType(), ApduTraceRecord::Type::COMMAND_CHUNK);
+    ASSERT_EQ(records[2].getPayload().size(), 45u);
+    ASSERT_EQ(records[3].getType(), ApduTraceRecord::Type::RESPONSE_CHUNK);
+    ASSERT_EQ(records[3].getPayload(), std::vector<uint8_t>({0x12, 0x34}));
+    ASSERT_EQ(records[4].getType(), ApduTraceRecord::Type::STREAM_ENDED);
+    ASSERT_EQ(records[4].getPayload(), std::vector<uint8_t>({0x90, 0x00}));
+}
+
+TEST(ApduTraceTest, record_whenFull_shouldDropOldestRecords)
+{
+    /* Room for about 6 records of 8 to 10 bytes */
+    ApduTraceBuffer traceBuffer(READER_NAME, 64);
+
+    for (uint8_t i = 0; i < 20; i++) {
+        const std::vector<uint8_t> payload = {i, i, i, i, i};
+        traceBuffer.record(ApduTraceRecord::Type::COMMAND, payload.data(), payload.size());
+    }
+
+    const ApduTraceDecoder decoder(traceBuffer.serialize());
+    const std::vector<ApduTraceRecord>& records = decoder.getRecords();
+
+    ASSERT_GE(records.size(), 1u);
+    ASSERT_EQ(decoder.getDroppedRecordCount() + records.size(), 20u);
+    ASSERT_EQ(traceBuffer.getDroppedRecordCount(), decoder.getDroppedRecordCount());
+    ASSERT_EQ(records.back().getPayload(), std::vector<uint8_t>(5, 19));
+    for (std::size_t i = 1; i < records.size(); i++) {
+        ASSERT_EQ(records[i].getPayload()[0], records[i - 1].getPayload()[0] + 1);
+    }
+}
+
+TEST(ApduTraceTest, record_whenLargerThanBuffer_shouldDropRecord)
+{
+    ApduTraceBuffer traceBuffer(READER_NAME, 8);
+    const std::vector<uint8_t> payload(16, 0xAA);
+
+    traceBuffer.record(ApduTraceRecord::Type::COMMAND, payload.data(), payload.size());
+
+    ASSERT_EQ(traceBuffer.getDroppedRecordCount(), 1u);
+    ASSERT_TRUE(ApduTraceDecoder(traceBuffer.serialize()).getRecords().empty());
+}
+
+TEST(ApduTraceTest, flushToFile_shouldBeDecodedFromFile)
+{
+    const std::string path = "ApduTraceTest.ktrc";
+    ApduTraceBuffer traceBuffer(READER_NAME);
+    traceBuffer.record(ApduTraceRecord::Type::COMMAND, APDU.data(), APDU.size());
+    traceBuffer.record(ApduTraceRecord::Type::RESPONSE, RESP.data(), RESP.size());
+
+    traceBuffer.flushToFile(path);
+    const ApduTraceDecoder decoder = ApduTraceDecoder::fromFile(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(decoder.getReaderName(), READER_NAME);
+    ASSERT_EQ(decoder.getRecords().size(), 2u);
+    ASSERT_EQ(decoder.getRecords()[0].getPayload(), APDU);
+    ASSERT_EQ(decoder.getRecords()[1].getPayload(), RESP);
+}
+
+TEST(ApduTraceTest, decoder_whenMalformed_shouldThrowIAE)
+{
+    std::vector<uint8_t> trace = ApduTraceBuffer(READER_NAME).serialize();
+    trace[0] = 'X';
+
+    EXPECT_THROW(ApduTraceDecoder decoder(trace), IllegalArgumentException);
+}
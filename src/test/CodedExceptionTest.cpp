@@ -0,0 +1,80 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <exception>
+#include <string>
+#include <type_traits>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "CardIOException.h"
+#include "PluginIOException.h"
+#include "ReaderIOException.h"
+#include "TaskCanceledException.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+
+/* A pointer to a transient string must not be accepted as a static message */
+static_assert(!std::is_constructible<CardIOException, int, const char*>::value,
+              "CardIOException accepts a non-literal message");
+static_assert(!std::is_constructible<TaskCanceledException, int, const char*>::value,
+              "TaskCanceledException accepts a non-literal message");
+
+static const char STATIC_MESSAGE[] = "Card removed";
+
+TEST(CodedExceptionTest, constructor_withString_shouldKeepMessage)
+{
+    const CardIOException e("Card removed");
+
+    ASSERT_EQ(e.getCategory(), CodedException::Category::CARD_IO);
+    ASSERT_EQ(e.getCode(), 0);
+    ASSERT_EQ(e.getMessage(), "Card removed");
+    ASSERT_STREQ(e.what(), "Card removed");
+    ASSERT_FALSE(e.getCauseException());
+}
+
+TEST(CodedExceptionTest, constructor_withStaticMessage_shouldReferenceMessage)
+{
+    const CardIOException e(42, STATIC_MESSAGE);
+
+    ASSERT_EQ(e.getCode(), 42);
+    ASSERT_EQ(e.what(), STATIC_MESSAGE);
+    ASSERT_EQ(e.getMessage(), "Card removed");
+    ASSERT_EQ(&e.getMessage(), &e.getMessage());
+}
+
+TEST(CodedExceptionTest, constructor_withCauseException_shouldRethrowCause)
+{
+    try {
+        try {
+            throw CardIOException(1, STATIC_MESSAGE);
+        } catch (const CardIOException&) {
+            throw ReaderIOException(2, "Transaction aborted", std::current_exception());
+        }
+    } catch (const ReaderIOException& e) {
+        ASSERT_EQ(e.getCategory(), CodedException::Category::READER_IO);
+        ASSERT_STREQ(e.what(), "Transaction aborted");
+        ASSERT_TRUE(e.getCauseException());
+        EXPECT_THROW(std::rethrow_exception(e.getCauseException()), CardIOException);
+    }
+}
+
+TEST(CodedExceptionTest, getCategory_shouldIdentifyExceptionType)
+{
+    ASSERT_EQ(PluginIOException(0, "").getCategory(), CodedException::Category::PLUGIN_IO);
+    ASSERT_EQ(TaskCanceledException(0, "").getCategory(),
+              CodedException::Category::TASK_CANCELED);
+}
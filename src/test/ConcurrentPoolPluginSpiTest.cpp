@@ -0,0 +1,537 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ConcurrentPoolPluginSpi.h"
+#include "PluginIOException.h"
+#include "RoundRobinAllocationPolicy.h"
+
+/* Keyple Util */
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+using namespace keyple::core::util::cpp::exception;
+
+static const std::string GROUP = "SAM_GROUP";
+static const std::string NAME = "POOL";
+
+class ConcurrentPoolPluginSpiStub final : public ConcurrentPoolPluginSpi {
+public:
+    explicit ConcurrentPoolPluginSpiStub(const std::size_t readerCount)
+    : ConcurrentPoolPluginSpi({{GROUP, createReaders(readerCount)}}) {}
+
+    explicit ConcurrentPoolPluginSpiStub(const std::vector<std::shared_ptr<ReaderSpi>>& readers)
+    : ConcurrentPoolPluginSpi({{GROUP, readers}}) {}
+
+    const std::string& getName() const override
+    {
+        return NAME;
+    }
+
+    void onUnregister() override {}
+
+private:
+    static std::vector<std::shared_ptr<ReaderSpi>> createReaders(const std::size_t readerCount)
+    {
+        std::vector<std::shared_ptr<ReaderSpi>> readers;
+        for (std::size_t i = 0; i < readerCount; i++) {
+            readers.push_back(std::make_shared<ReaderSpiMock>());
+        }
+
+        return readers;
+    }
+};
+
+/**
+ * Selects the last free reader, failing the first selections and optionally each release.
+ */
+class FailingPolicy final : public ReaderAllocationPolicySpi {
+public:
+    FailingPolicy(const int selectionFailureCount, const bool isReleaseFailing)
+    : mSelectionFailureCount(selectionFailureCount), mIsReleaseFailing(isReleaseFailing) {}
+
+    std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                             const std::string&) override
+    {
+        if (mSelectionFailureCount > 0) {
+            mSelectionFailureCount--;
+            throw IllegalStateException("Selection failure");
+        }
+
+        return freeReaders.size() - 1;
+    }
+
+    void onReaderReleased(const std::shared_ptr<ReaderSpi>&) override
+    {
+        if (mIsReleaseFailing) {
+            throw IllegalStateException("Release failure");
+        }
+    }
+
+private:
+    int mSelectionFailureCount;
+    const bool mIsReleaseFailing;
+};
+
+/**
+ * Reader whose physical channel state follows the open and close requests.
+ */
+class ChannelReaderMock : public ReaderSpiMock {
+public:
+    ChannelReaderMock() : mIsOpen(false)
+    {
+        ON_CALL(*this, openPhysicalChannel()).WillByDefault(Invoke([this] { mIsOpen = true; }));
+        ON_CALL(*this, closePhysicalChannel()).WillByDefault(Invoke([this] { mIsOpen = false; }));
+        ON_CALL(*this, isPhysicalChannelOpen()).WillByDefault(Invoke([this] { return mIsOpen; }));
+    }
+
+    bool mIsOpen;
+};
+
+static std::vector<std::shared_ptr<ReaderSpi>> createChannelReaders(const std::size_t readerCount)
+{
+    std::vector<std::shared_ptr<ReaderSpi>> readers;
+    for (std::size_t i = 0; i < readerCount; i++) {
+        readers.push_back(std::make_shared<NiceMock<ChannelReaderMock>>());
+    }
+
+    return readers;
+}
+
+static bool isOpen(const std::shared_ptr<ReaderSpi>& reader)
+{
+    return std::dynamic_pointer_cast<ChannelReaderMock>(reader)->mIsOpen;
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReader_shouldAllocateEachReaderOnce)
+{
+    ConcurrentPoolPluginSpiStub pool(2);
+
+    std::shared_ptr<ReaderSpi> reader1 = pool.allocateReader(GROUP);
+    std::shared_ptr<ReaderSpi> reader2 = pool.tryAllocateReader(GROUP);
+
+    ASSERT_NE(reader1, nullptr);
+    ASSERT_NE(reader2, nullptr);
+    ASSERT_NE(reader1, reader2);
+    ASSERT_EQ(pool.tryAllocateReader(GROUP), nullptr);
+
+    pool.releaseReader(reader1);
+    ASSERT_EQ(pool.tryAllocateReader(GROUP), reader1);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReader_whenGroupIsUnknown_shouldThrowPIOE)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+
+    EXPECT_THROW(pool.allocateReader("UNKNOWN"), PluginIOException);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, releaseReader_whenNotAllocated_shouldThrowPIOE)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+    pool.releaseReader(reader);
+
+    EXPECT_THROW(pool.releaseReader(reader), PluginIOException);
+    EXPECT_THROW(pool.releaseReader(std::make_shared<ReaderSpiMock>()), PluginIOException);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, tryAllocateReaderFor_whenNoReaderIsReleased_shouldTimeOut)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    pool.allocateReader(GROUP);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(pool.tryAllocateReaderFor(GROUP, std::chrono::milliseconds(20)), nullptr);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getAllocationFailureCount(), 1u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, tryAllocateReaderFor_whenTimeoutIsZero_shouldNotWait)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+
+    std::shared_ptr<ReaderSpi> reader =
+        pool.tryAllocateReaderFor(GROUP, std::chrono::milliseconds(0));
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(pool.tryAllocateReaderFor(GROUP, std::chrono::milliseconds(0)), nullptr);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, tryAllocateReaderFor_whenTimeoutIsMax_shouldWaitForRelease)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+
+    std::shared_ptr<ReaderSpi> allocated;
+    std::thread waiter([&pool, &allocated] {
+        allocated = pool.tryAllocateReaderFor(GROUP, std::chrono::milliseconds::max());
+    });
+    while (pool.getWaiterCount(GROUP) != 1) {
+        std::this_thread::yield();
+    }
+
+    pool.releaseReader(reader);
+    waiter.join();
+
+    ASSERT_EQ(allocated, reader);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReader_whenWaiting_shouldBeServedInArrivalOrder)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+
+    std::vector<int> servedOrder;
+    std::mutex servedOrderMutex;
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 3; i++) {
+        waiters.push_back(std::thread([&pool, &servedOrder, &servedOrderMutex, i] {
+            std::shared_ptr<ReaderSpi> allocated = pool.allocateReader(GROUP);
+            {
+                std::lock_guard<std::mutex> lock(servedOrderMutex);
+                servedOrder.push_back(i);
+            }
+            pool.releaseReader(allocated);
+        }));
+        /* Lets the waiter queue up before the next one */
+        while (pool.getWaiterCount(GROUP) != static_cast<std::size_t>(i + 1)) {
+            std::this_thread::yield();
+        }
+    }
+
+    /* A later caller must not overtake the waiting ones */
+    ASSERT_EQ(pool.tryAllocateReader(GROUP), nullptr);
+
+    pool.releaseReader(reader);
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    ASSERT_EQ(servedOrder, std::vector<int>({0, 1, 2}));
+}
+
+TEST(ConcurrentPoolPluginSpiTest, releaseReader_whenPolicyFails_shouldPassErrorToWaiter)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+    pool.setAllocationPolicy(GROUP, std::make_shared<FailingPolicy>(1000, false));
+
+    std::atomic<bool> isFailed(false);
+    std::thread waiter([&pool, &isFailed] {
+        try {
+            pool.allocateReader(GROUP);
+        } catch (const IllegalStateException&) {
+            isFailed = true;
+        }
+    });
+    while (pool.getWaiterCount(GROUP) != 1) {
+        std::this_thread::yield();
+    }
+
+    pool.releaseReader(reader);
+    waiter.join();
+
+    ASSERT_TRUE(isFailed);
+    ASSERT_EQ(pool.getWaiterCount(GROUP), 0u);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 1u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, releaseReader_whenPolicyFailsOnce_shouldServeNextWaiter)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+    pool.setAllocationPolicy(GROUP, std::make_shared<FailingPolicy>(1, false));
+
+    std::atomic<bool> isFirstFailed(false);
+    std::thread first([&pool, &isFirstFailed] {
+        try {
+            pool.allocateReader(GROUP);
+        } catch (const IllegalStateException&) {
+            isFirstFailed = true;
+        }
+    });
+    while (pool.getWaiterCount(GROUP) != 1) {
+        std::this_thread::yield();
+    }
+    std::shared_ptr<ReaderSpi> secondReader;
+    std::thread second([&pool, &secondReader] {
+        secondReader = pool.tryAllocateReaderFor(GROUP, std::chrono::seconds(10));
+    });
+    while (pool.getWaiterCount(GROUP) != 2) {
+        std::this_thread::yield();
+    }
+
+    pool.releaseReader(reader);
+    first.join();
+    second.join();
+
+    ASSERT_TRUE(isFirstFailed);
+    ASSERT_EQ(secondReader, reader);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 0u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, releaseReader_whenPolicyNotificationFails_shouldFreeReader)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+    pool.setAllocationPolicy(GROUP, std::make_shared<FailingPolicy>(0, true));
+
+    EXPECT_THROW(pool.releaseReader(reader), IllegalStateException);
+
+    ASSERT_EQ(pool.tryAllocateReader(GROUP), reader);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReaderAsync_whenPolicyFails_shouldPassErrorToCallback)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    pool.setAllocationPolicy(GROUP, std::make_shared<FailingPolicy>(1, false));
+
+    std::exception_ptr error;
+    pool.allocateReaderAsync(
+        GROUP, [&error](std::shared_ptr<ReaderSpi>, std::exception_ptr e) { error = e; });
+
+    ASSERT_TRUE(error);
+    EXPECT_THROW(std::rethrow_exception(error), IllegalStateException);
+    ASSERT_NE(pool.tryAllocateReader(GROUP), nullptr);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReaders_whenPolicyFails_shouldReleaseAllocatedReaders)
+{
+    class SecondSelectionFailingPolicy final : public ReaderAllocationPolicySpi {
+    public:
+        std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>& freeReaders,
+                                 const std::string&) override
+        {
+            if (++mSelectionCount == 2) {
+                throw IllegalStateException("Selection failure");
+            }
+
+            return freeReaders.size() - 1;
+        }
+
+    private:
+        int mSelectionCount = 0;
+    };
+
+    ConcurrentPoolPluginSpiStub pool(3);
+    pool.setAllocationPolicy(GROUP, std::make_shared<SecondSelectionFailingPolicy>());
+
+    EXPECT_THROW(pool.allocateReaders(GROUP, 3, PoolPluginSpi::BulkAllocationMode::BEST_EFFORT),
+                 IllegalStateException);
+
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 3u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReaderAsync_whenNoReaderIsFree_shouldCallBackOnRelease)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+
+    std::shared_ptr<ReaderSpi> allocated;
+    pool.allocateReaderAsync(GROUP,
+                             [&allocated](std::shared_ptr<ReaderSpi> readerSpi,
+                                          std::exception_ptr) { allocated = readerSpi; });
+    ASSERT_EQ(allocated, nullptr);
+
+    pool.releaseReader(reader);
+    ASSERT_EQ(allocated, reader);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReaders_shouldNotWait)
+{
+    ConcurrentPoolPluginSpiStub pool(3);
+
+    EXPECT_THROW(pool.allocateReaders(GROUP, 4, PoolPluginSpi::BulkAllocationMode::ALL_OR_NOTHING),
+                 PluginIOException);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 3u);
+
+    ASSERT_EQ(pool.allocateReaders(GROUP, 4, PoolPluginSpi::BulkAllocationMode::BEST_EFFORT)
+                  .size(),
+              3u);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 0u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, setAllocationPolicy_shouldSelectWithPolicy)
+{
+    class FirstReaderPolicy final : public ReaderAllocationPolicySpi {
+    public:
+        std::size_t selectReader(const std::vector<std::shared_ptr<ReaderSpi>>&,
+                                 const std::string& affinityKey) override
+        {
+            mAffinityKey = affinityKey;
+            return 0;
+        }
+
+        std::string mAffinityKey;
+    };
+
+    ConcurrentPoolPluginSpiStub pool(2);
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        pool.allocateReaders(GROUP, 2, PoolPluginSpi::BulkAllocationMode::ALL_OR_NOTHING);
+    pool.releaseReader(readers[1]);
+    pool.releaseReader(readers[0]);
+
+    /* Without policy, the last released reader is allocated */
+    auto policy = std::make_shared<FirstReaderPolicy>();
+    pool.setAllocationPolicy(GROUP, policy);
+
+    ASSERT_EQ(pool.allocateReaderWithAffinity(GROUP, "CARD"), readers[1]);
+    ASSERT_EQ(policy->mAffinityKey, "CARD");
+    EXPECT_THROW(pool.setAllocationPolicy("UNKNOWN",
+                                          std::make_shared<RoundRobinAllocationPolicy>()),
+                 IllegalArgumentException);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReader_whenContended_shouldNeverShareReaders)
+{
+    ConcurrentPoolPluginSpiStub pool(4);
+    std::atomic<int> holders[4];
+    for (auto& holder : holders) {
+        holder.store(0);
+    }
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        pool.allocateReaders(GROUP, 4, PoolPluginSpi::BulkAllocationMode::ALL_OR_NOTHING);
+    pool.releaseReaders(readers);
+
+    std::atomic<bool> isShared(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 16; t++) {
+        workers.push_back(std::thread([&] {
+            for (int i = 0; i < 500; i++) {
+                std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+                const std::size_t index =
+                    std::find(readers.begin(), readers.end(), reader) - readers.begin();
+                if (holders[index].fetch_add(1) != 0) {
+                    isShared = true;
+                }
+                holders[index].fetch_sub(1);
+                pool.releaseReader(reader);
+            }
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    ASSERT_FALSE(isShared);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 4u);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getAllocationCount(), 16u * 500u + 4u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, setWarmPoolSize_shouldOpenChannelsOfFreeReaders)
+{
+    const std::vector<std::shared_ptr<ReaderSpi>> readers = createChannelReaders(3);
+    ConcurrentPoolPluginSpiStub pool(readers);
+
+    ASSERT_EQ(pool.getWarmPoolSize(GROUP), 0u);
+
+    pool.setWarmPoolSize(GROUP, 2);
+
+    ASSERT_EQ(pool.getWarmPoolSize(GROUP), 2u);
+    ASSERT_EQ(pool.getWarmPoolStatistics(GROUP).getWarmReaderCount(), 2u);
+    ASSERT_EQ(std::count_if(readers.begin(), readers.end(), isOpen), 2);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 3u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, allocateReader_whenWarmPoolIsEnabled_shouldCountHitsAndMisses)
+{
+    ConcurrentPoolPluginSpiStub pool(createChannelReaders(2));
+    pool.setWarmPoolSize(GROUP, 1);
+
+    std::shared_ptr<ReaderSpi> reader1 = pool.allocateReader(GROUP);
+    std::shared_ptr<ReaderSpi> reader2 = pool.allocateReader(GROUP);
+
+    ASSERT_TRUE(isOpen(reader1));
+    ASSERT_FALSE(isOpen(reader2));
+
+    const WarmPoolStatistics statistics = pool.getWarmPoolStatistics(GROUP);
+    ASSERT_EQ(statistics.getWarmReaderCount(), 0u);
+    ASSERT_EQ(statistics.getHitCount(), 1u);
+    ASSERT_EQ(statistics.getMissCount(), 1u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, releaseReader_whenWarmPoolIsFull_shouldCloseChannel)
+{
+    ConcurrentPoolPluginSpiStub pool(createChannelReaders(2));
+    pool.setWarmPoolSize(GROUP, 1);
+
+    std::shared_ptr<ReaderSpi> reader1 = pool.allocateReader(GROUP);
+    std::shared_ptr<ReaderSpi> reader2 = pool.allocateReader(GROUP);
+    reader2->openPhysicalChannel();
+
+    pool.releaseReader(reader1);
+    pool.releaseReader(reader2);
+
+    ASSERT_TRUE(isOpen(reader1));
+    ASSERT_FALSE(isOpen(reader2));
+    ASSERT_EQ(pool.getWarmPoolStatistics(GROUP).getWarmReaderCount(), 1u);
+    ASSERT_EQ(pool.allocateReader(GROUP), reader1);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, setWarmPoolSize_whenZero_shouldCloseChannels)
+{
+    const std::vector<std::shared_ptr<ReaderSpi>> readers = createChannelReaders(2);
+    ConcurrentPoolPluginSpiStub pool(readers);
+    pool.setWarmPoolSize(GROUP, 2);
+
+    pool.setWarmPoolSize(GROUP, 0);
+
+    ASSERT_EQ(std::count_if(readers.begin(), readers.end(), isOpen), 0);
+    ASSERT_EQ(pool.getWarmPoolStatistics(GROUP).getWarmReaderCount(), 0u);
+    ASSERT_EQ(pool.getReaderGroupStatistics(GROUP).getFreeReaderCount(), 2u);
+
+    pool.allocateReader(GROUP);
+    ASSERT_EQ(pool.getWarmPoolStatistics(GROUP).getMissCount(), 0u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, setWarmPoolSize_whenReaderIsAwaited_shouldServeWaiter)
+{
+    ConcurrentPoolPluginSpiStub pool(createChannelReaders(1));
+    pool.setWarmPoolSize(GROUP, 1);
+    std::shared_ptr<ReaderSpi> reader = pool.allocateReader(GROUP);
+
+    std::shared_ptr<ReaderSpi> allocatedReader;
+    pool.allocateReaderAsync(
+        GROUP,
+        [&allocatedReader](const std::shared_ptr<ReaderSpi>& readerSpi, std::exception_ptr) {
+            allocatedReader = readerSpi;
+        });
+    pool.releaseReader(reader);
+
+    ASSERT_EQ(allocatedReader, reader);
+    ASSERT_EQ(pool.getWarmPoolStatistics(GROUP).getHitCount(), 2u);
+}
+
+TEST(ConcurrentPoolPluginSpiTest, setWarmPoolSize_whenGroupIsUnknown_shouldThrowIAE)
+{
+    ConcurrentPoolPluginSpiStub pool(1);
+
+    EXPECT_THROW(pool.setWarmPoolSize("UNKNOWN", 1), IllegalArgumentException);
+    EXPECT_THROW(pool.getWarmPoolSize("UNKNOWN"), IllegalArgumentException);
+    EXPECT_THROW(pool.getWarmPoolStatistics("UNKNOWN"), IllegalArgumentException);
+}
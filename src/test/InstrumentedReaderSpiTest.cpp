@@ -0,0 +1,87 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "CardIOException.h"
+#include "InstrumentedReaderSpi.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+
+static const std::vector<uint8_t> APDU = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> RESP = {0x12, 0x34, 0x90, 0x00};
+
+TEST(InstrumentedReaderSpiTest, transmitApdu_shouldRecordLatencyAndBytes)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(APDU)).Times(2).WillRepeatedly(Return(RESP));
+
+    int listenerCalls = 0;
+    InstrumentedReaderSpi instrumented(
+        reader, [&listenerCalls](const std::chrono::nanoseconds&) { listenerCalls++; });
+
+    instrumented.transmitApdu(APDU);
+    instrumented.transmitApdu(APDU);
+
+    const ReaderMetrics metrics = instrumented.getMetrics();
+    const ReaderMetrics::OperationMetrics& transmit =
+        metrics.getOperationMetrics(ReaderMetrics::Operation::TRANSMIT_APDU);
+
+    ASSERT_EQ(transmit.getCount(), 2u);
+    ASSERT_EQ(transmit.getErrorCount(), 0u);
+    ASSERT_EQ(metrics.getBytesSent(), 10u);
+    ASSERT_EQ(metrics.getBytesReceived(), 8u);
+    ASSERT_EQ(listenerCalls, 2);
+}
+
+TEST(InstrumentedReaderSpiTest, openPhysicalChannel_whenFailing_shouldCountError)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, openPhysicalChannel()).WillOnce(Throw(CardIOException("No card")));
+
+    InstrumentedReaderSpi instrumented(reader);
+
+    EXPECT_THROW(instrumented.openPhysicalChannel(), CardIOException);
+
+    const ReaderMetrics metrics = instrumented.getMetrics();
+    const ReaderMetrics::OperationMetrics& open =
+        metrics.getOperationMetrics(ReaderMetrics::Operation::OPEN_PHYSICAL_CHANNEL);
+
+    ASSERT_EQ(open.getCount(), 1u);
+    ASSERT_EQ(open.getErrorCount(), 1u);
+}
+
+TEST(InstrumentedReaderSpiTest, tryOpenPhysicalChannel_whenFailing_shouldCountError)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, openPhysicalChannel()).WillOnce(Throw(CardIOException("No card")));
+
+    InstrumentedReaderSpi instrumented(reader);
+
+    ASSERT_EQ(instrumented.tryOpenPhysicalChannel().getCode(),
+              ReaderStatus::Code::CARD_IO_ERROR);
+
+    const ReaderMetrics metrics = instrumented.getMetrics();
+    const ReaderMetrics::OperationMetrics& open =
+        metrics.getOperationMetrics(ReaderMetrics::Operation::OPEN_PHYSICAL_CHANNEL);
+
+    ASSERT_EQ(open.getCount(), 1u);
+    ASSERT_EQ(open.getErrorCount(), 1u);
+}
@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ParsedPowerOnData.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::spi::reader;
+
+TEST(ParsedPowerOnDataTest, parse_whenContactAtr_shouldDecodeInterfaceAndHistoricalBytes)
+{
+    const ParsedPowerOnData parsed = ParsedPowerOnData::parse("3B169641737472696400");
+
+    ASSERT_EQ(parsed.getFormat(), ParsedPowerOnData::Format::ATR);
+    ASSERT_FALSE(parsed.isContactless());
+    ASSERT_FALSE(parsed.isInverseConvention());
+    ASSERT_TRUE(parsed.isProtocolIndicated(0));
+    ASSERT_FALSE(parsed.isProtocolIndicated(1));
+    ASSERT_EQ(parsed.getTa1(), 0x96);
+    ASSERT_THAT(parsed.getHistoricalBytes(), ElementsAre(0x41, 0x73, 0x74, 0x72, 0x69, 0x64));
+}
+
+TEST(ParsedPowerOnDataTest, parse_whenPcscStorageCardAtr_shouldDecodeCardName)
+{
+    const ParsedPowerOnData parsed =
+        ParsedPowerOnData::parse("3B8F8001804F0CA000000306030001000000006A");
+
+    ASSERT_EQ(parsed.getFormat(), ParsedPowerOnData::Format::ATR);
+    ASSERT_TRUE(parsed.isContactless());
+    ASSERT_TRUE(parsed.isProtocolIndicated(0));
+    ASSERT_TRUE(parsed.isProtocolIndicated(1));
+    ASSERT_TRUE(parsed.isChecksumValid());
+    ASSERT_EQ(parsed.getPcscStandard(), 0x03);
+    ASSERT_EQ(parsed.getPcscCardName(), 0x0001);
+}
+
+TEST(ParsedPowerOnDataTest, parse_whenAts_shouldDecodeAtsFields)
+{
+    const uint8_t ats[] = {0x06, 0x75, 0x77, 0x81, 0x02, 0x80};
+    const ParsedPowerOnData parsed = ParsedPowerOnData::parse(ats, sizeof(ats));
+
+    ASSERT_EQ(parsed.getFormat(), ParsedPowerOnData::Format::ATS);
+    ASSERT_TRUE(parsed.isContactless());
+    ASSERT_EQ(parsed.getAtsFsci(), 5);
+    ASSERT_EQ(parsed.getAtsTa(), 0x77);
+    ASSERT_EQ(parsed.getAtsTb(), 0x81);
+    ASSERT_EQ(parsed.getAtsTc(), 0x02);
+    ASSERT_THAT(parsed.getHistoricalBytes(), ElementsAre(0x80));
+}
+
+TEST(ParsedPowerOnDataTest, parse_whenTruncatedOrInvalid_shouldReturnUnknown)
+{
+    ASSERT_EQ(ParsedPowerOnData::parse("3B1696").getFormat(), ParsedPowerOnData::Format::UNKNOWN);
+    ASSERT_EQ(ParsedPowerOnData::parse("3G").getFormat(), ParsedPowerOnData::Format::UNKNOWN);
+    ASSERT_EQ(ParsedPowerOnData::parse("").getFormat(), ParsedPowerOnData::Format::UNKNOWN);
+}
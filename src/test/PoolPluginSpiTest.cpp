@@ -0,0 +1,105 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <stdexcept>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "PluginIOException.h"
+#include "PoolPluginSpi.h"
+
+/* Mock */
+#include "mock/PoolPluginSpiMock.h"
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi;
+
+static const std::string GROUP = "SAM_GROUP";
+
+TEST(PoolPluginSpiTest, allocateReaders_whenAllReadersAreAvailable_shouldReturnThem)
+{
+    PoolPluginSpiMock pool;
+    EXPECT_CALL(pool, allocateReader(GROUP))
+        .Times(3)
+        .WillRepeatedly(Return(std::make_shared<ReaderSpiMock>()));
+
+    ASSERT_EQ(pool.allocateReaders(GROUP, 3, PoolPluginSpi::BulkAllocationMode::ALL_OR_NOTHING)
+                  .size(),
+              3u);
+}
+
+TEST(PoolPluginSpiTest, allocateReaders_whenAllOrNothingFails_shouldReleaseAndThrow)
+{
+    PoolPluginSpiMock pool;
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(pool, allocateReader(GROUP))
+        .WillOnce(Return(reader))
+        .WillOnce(Throw(PluginIOException("No reader available")));
+    EXPECT_CALL(pool, releaseReader(std::shared_ptr<ReaderSpi>(reader))).Times(1);
+
+    EXPECT_THROW(pool.allocateReaders(GROUP, 3, PoolPluginSpi::BulkAllocationMode::ALL_OR_NOTHING),
+                 PluginIOException);
+}
+
+TEST(PoolPluginSpiTest, allocateReaders_whenBestEffortFails_shouldReturnAllocatedReaders)
+{
+    PoolPluginSpiMock pool;
+    EXPECT_CALL(pool, allocateReader(GROUP))
+        .WillOnce(Return(std::make_shared<ReaderSpiMock>()))
+        .WillOnce(Throw(PluginIOException("No reader available")));
+    EXPECT_CALL(pool, releaseReader(_)).Times(0);
+
+    ASSERT_EQ(pool.allocateReaders(GROUP, 3, PoolPluginSpi::BulkAllocationMode::BEST_EFFORT).size(),
+              1u);
+}
+
+TEST(PoolPluginSpiTest, releaseReaders_whenOneReleaseFails_shouldReleaseAllAndThrow)
+{
+    PoolPluginSpiMock pool;
+    EXPECT_CALL(pool, releaseReader(_))
+        .WillOnce(Throw(PluginIOException("Release failed")))
+        .WillOnce(Return());
+
+    EXPECT_THROW(pool.releaseReaders({std::make_shared<ReaderSpiMock>(),
+                                      std::make_shared<ReaderSpiMock>()}),
+                 PluginIOException);
+}
+
+TEST(PoolPluginSpiTest, allocateReaders_whenUnexpectedErrorOccurs_shouldReleaseAndRethrow)
+{
+    PoolPluginSpiMock pool;
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(pool, allocateReader(GROUP))
+        .WillOnce(Return(reader))
+        .WillOnce(Throw(std::runtime_error("Connection lost")));
+    EXPECT_CALL(pool, releaseReader(std::shared_ptr<ReaderSpi>(reader))).Times(1);
+
+    EXPECT_THROW(pool.allocateReaders(GROUP, 3, PoolPluginSpi::BulkAllocationMode::BEST_EFFORT),
+                 std::runtime_error);
+}
+
+TEST(PoolPluginSpiTest, releaseReaders_whenUnexpectedErrorOccurs_shouldReleaseAllAndRethrow)
+{
+    PoolPluginSpiMock pool;
+    EXPECT_CALL(pool, releaseReader(_))
+        .WillOnce(Throw(std::runtime_error("Connection lost")))
+        .WillOnce(Return());
+
+    EXPECT_THROW(pool.releaseReaders({std::make_shared<ReaderSpiMock>(),
+                                      std::make_shared<ReaderSpiMock>()}),
+                 std::runtime_error);
+}
@@ -0,0 +1,51 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "PowerOnDataCache.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::cpp;
+
+static const uint8_t ATR[] = {0x3B, 0x8F, 0x80, 0x01, 0x80};
+
+TEST(PowerOnDataCacheTest, set_shouldExposeBytesAndHexString)
+{
+    PowerOnDataCache cache;
+    cache.set(ATR, sizeof(ATR));
+
+    const PowerOnDataView view = cache.getView();
+
+    ASSERT_TRUE(view.isValid());
+    ASSERT_EQ(std::vector<uint8_t>(view.getData(), view.getData() + view.getSize()),
+              std::vector<uint8_t>(ATR, ATR + sizeof(ATR)));
+    ASSERT_EQ(cache.getHexString(), "3B8F800180");
+}
+
+TEST(PowerOnDataCacheTest, setAndClear_shouldChangeGeneration)
+{
+    PowerOnDataCache cache;
+    const uint64_t initialGeneration = cache.getView().getGeneration();
+
+    cache.set(ATR, sizeof(ATR));
+    const uint64_t openGeneration = cache.getView().getGeneration();
+    cache.clear();
+
+    ASSERT_NE(openGeneration, initialGeneration);
+    ASSERT_NE(cache.getView().getGeneration(), openGeneration);
+    ASSERT_EQ(cache.getView().getSize(), 0u);
+    ASSERT_TRUE(cache.getHexString().empty());
+}
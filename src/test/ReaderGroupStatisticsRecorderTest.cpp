@@ -0,0 +1,50 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ReaderGroupStatisticsRecorder.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::cpp;
+
+TEST(ReaderGroupStatisticsRecorderTest, getBucketIndex_shouldUsePowerOfTwoMicroseconds)
+{
+    ASSERT_EQ(LatencyHistogram::getBucketIndex(999), 0u);
+    ASSERT_EQ(LatencyHistogram::getBucketIndex(1000), 1u);
+    ASSERT_EQ(LatencyHistogram::getBucketIndex(3999), 2u);
+    ASSERT_EQ(LatencyHistogram::getBucketIndex(4000), 3u);
+    ASSERT_EQ(LatencyHistogram::getBucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(ReaderGroupStatisticsRecorderTest, getStatistics_shouldReflectRecords)
+{
+    ReaderGroupStatisticsRecorder recorder;
+    recorder.recordAllocation(std::chrono::microseconds(3));
+    recorder.recordAllocation(std::chrono::microseconds(3));
+    recorder.recordAllocationFailure();
+    recorder.recordRelease(std::chrono::milliseconds(10));
+    recorder.recordRelease(std::chrono::milliseconds(20));
+
+    const ReaderGroupStatistics statistics = recorder.getStatistics(8, 6);
+
+    ASSERT_EQ(statistics.getTotalReaderCount(), 8u);
+    ASSERT_EQ(statistics.getFreeReaderCount(), 6u);
+    ASSERT_EQ(statistics.getAllocatedReaderCount(), 2u);
+    ASSERT_EQ(statistics.getAllocationCount(), 2u);
+    ASSERT_EQ(statistics.getAllocationFailureCount(), 1u);
+    ASSERT_EQ(statistics.getAllocationWaitTimeHistogram()[2], 2u);
+    ASSERT_EQ(statistics.getMeanHoldTime(), std::chrono::milliseconds(15));
+}
@@ -0,0 +1,72 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ReaderNamesJournal.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::cpp;
+
+TEST(ReaderNamesJournalTest, getChangesSince_whenEpochIsCurrent_shouldReturnNoChange)
+{
+    ReaderNamesJournal journal;
+    journal.onReaderConnected("READER_1");
+
+    std::vector<std::string> connected;
+    std::vector<std::string> disconnected;
+
+    ASSERT_TRUE(journal.getChangesSince(journal.getEpoch(), connected, disconnected));
+    ASSERT_TRUE(connected.empty());
+    ASSERT_TRUE(disconnected.empty());
+}
+
+TEST(ReaderNamesJournalTest, getChangesSince_shouldReturnNetChanges)
+{
+    ReaderNamesJournal journal;
+    journal.onReaderConnected("READER_1");
+    const uint64_t epoch = journal.getEpoch();
+
+    journal.onReaderConnected("READER_2");
+    journal.onReaderConnected("READER_3");
+    journal.onReaderDisconnected("READER_3");
+    journal.onReaderDisconnected("READER_1");
+    journal.onReaderConnected("READER_1");
+    journal.onReaderDisconnected("READER_4");
+
+    std::vector<std::string> connected;
+    std::vector<std::string> disconnected;
+
+    ASSERT_TRUE(journal.getChangesSince(epoch, connected, disconnected));
+    ASSERT_THAT(connected, ElementsAre("READER_1", "READER_2"));
+    ASSERT_THAT(disconnected, ElementsAre("READER_1", "READER_4"));
+}
+
+TEST(ReaderNamesJournalTest, getChangesSince_whenEpochIsTooOld_shouldReturnFalse)
+{
+    ReaderNamesJournal journal(2);
+    const uint64_t epoch = journal.getEpoch();
+
+    journal.onReaderConnected("READER_1");
+    journal.onReaderConnected("READER_2");
+    journal.onReaderConnected("READER_3");
+
+    std::vector<std::string> connected;
+    std::vector<std::string> disconnected;
+
+    ASSERT_FALSE(journal.getChangesSince(epoch, connected, disconnected));
+    ASSERT_TRUE(journal.getChangesSince(epoch + 1, connected, disconnected));
+    ASSERT_THAT(connected, ElementsAre("READER_2", "READER_3"));
+}
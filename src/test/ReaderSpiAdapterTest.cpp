@@ -0,0 +1,74 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "AsyncReaderSpiAdapter.h"
+#include "BlockingReaderSpiAdapter.h"
+#include "CardIOException.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+
+static const std::vector<uint8_t> APDU = {0x00, 0x84, 0x00, 0x00, 0x08};
+static const std::vector<uint8_t> RESP =
+    {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x90, 0x00};
+
+TEST(ReaderSpiAdapterTest, transmitApdu_whenAdaptedBothWays_shouldReturnResponse)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(APDU)).WillOnce(Return(RESP));
+
+    BlockingReaderSpiAdapter adapter(std::make_shared<AsyncReaderSpiAdapter>(reader));
+
+    ASSERT_EQ(adapter.transmitApdu(APDU), RESP);
+}
+
+TEST(ReaderSpiAdapterTest, transmitApdu_whenAdaptedBothWays_shouldRethrowCardIOException)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(APDU)).WillOnce(Throw(CardIOException("Card removed")));
+
+    BlockingReaderSpiAdapter adapter(std::make_shared<AsyncReaderSpiAdapter>(reader));
+
+    EXPECT_THROW(adapter.transmitApdu(APDU), CardIOException);
+}
+
+TEST(ReaderSpiAdapterTest, checkCardPresence_whenRunOnExecutor_shouldCompleteLater)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, checkCardPresence()).WillOnce(Return(true));
+
+    std::vector<std::function<void()>> tasks;
+    AsyncReaderSpiAdapter adapter(reader, [&tasks](const std::function<void()>& task) {
+        tasks.push_back(task);
+    });
+
+    bool result = false;
+    adapter.checkCardPresence([&result](bool isCardPresent, std::exception_ptr error) {
+        result = isCardPresent && !error;
+    });
+
+    ASSERT_FALSE(result);
+    ASSERT_EQ(tasks.size(), 1u);
+
+    tasks[0]();
+
+    ASSERT_TRUE(result);
+}
@@ -0,0 +1,229 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "CardIOException.h"
+#include "ReaderIOException.h"
+#include "ReaderSpi.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi::reader;
+
+static const std::vector<uint8_t> APDU = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> RESP_OK = {0x12, 0x34, 0x90, 0x00};
+static const std::vector<uint8_t> RESP_KO = {0x6A, 0x82};
+
+TEST(ReaderSpiTest, transmitApduInto_whenBufferIsLargeEnough_shouldCopyResponse)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU)).WillOnce(Return(RESP_OK));
+
+    uint8_t apduOut[258];
+    const std::size_t length = reader.transmitApduInto(APDU.data(), APDU.size(), apduOut, 258);
+
+    ASSERT_EQ(std::vector<uint8_t>(apduOut, apduOut + length), RESP_OK);
+}
+
+TEST(ReaderSpiTest, transmitApduInto_whenBufferIsTooSmall_shouldThrowIAE)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU)).WillOnce(Return(RESP_OK));
+
+    uint8_t apduOut[2];
+    EXPECT_THROW(reader.transmitApduInto(APDU.data(), APDU.size(), apduOut, 2),
+                 IllegalArgumentException);
+}
+
+TEST(ReaderSpiTest, transmitApduInto_whenBufferIsShorterThanStatusWord_shouldNotTransmit)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(_)).Times(0);
+
+    uint8_t apduOut[1];
+    EXPECT_THROW(reader.transmitApduInto(APDU.data(), APDU.size(), apduOut, 1),
+                 IllegalArgumentException);
+}
+
+TEST(ReaderSpiTest, tryTransmitApdu_whenSuccessful_shouldReturnOk)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU)).WillOnce(Return(RESP_OK));
+
+    uint8_t apduOut[258];
+    std::size_t length = 0;
+    const ReaderStatus status =
+        reader.tryTransmitApdu(APDU.data(), APDU.size(), apduOut, 258, length);
+
+    ASSERT_TRUE(status.isOk());
+    ASSERT_EQ(std::vector<uint8_t>(apduOut, apduOut + length), RESP_OK);
+}
+
+TEST(ReaderSpiTest, tryTransmitApdu_whenCardIsRemoved_shouldReturnCardIOError)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU)).WillOnce(Throw(CardIOException("Card removed")));
+
+    uint8_t apduOut[258];
+    std::size_t length = 0;
+    const ReaderStatus status =
+        reader.tryTransmitApdu(APDU.data(), APDU.size(), apduOut, 258, length);
+
+    ASSERT_EQ(status.getCode(), ReaderStatus::Code::CARD_IO_ERROR);
+    ASSERT_EQ(length, 0u);
+    EXPECT_THROW(status.throwIfError(), CardIOException);
+}
+
+TEST(ReaderSpiTest, tryTransmitApdu_whenBufferIsTooSmall_shouldReturnInvalidArgument)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU)).WillOnce(Return(RESP_OK));
+
+    uint8_t apduOut[2];
+    std::size_t length = 0;
+    const ReaderStatus status =
+        reader.tryTransmitApdu(APDU.data(), APDU.size(), apduOut, 2, length);
+
+    ASSERT_EQ(status.getCode(), ReaderStatus::Code::INVALID_ARGUMENT);
+    EXPECT_THROW(status.throwIfError(), IllegalArgumentException);
+}
+
+TEST(ReaderSpiTest, tryCheckCardPresence_whenReaderFails_shouldReturnReaderIOError)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, checkCardPresence())
+        .WillOnce(Return(true))
+        .WillOnce(Throw(ReaderIOException(9, "Reader unplugged")));
+
+    bool isCardPresent = false;
+    ASSERT_TRUE(reader.tryCheckCardPresence(isCardPresent).isOk());
+    ASSERT_TRUE(isCardPresent);
+
+    const ReaderStatus status = reader.tryCheckCardPresence(isCardPresent);
+    ASSERT_EQ(status.getCode(), ReaderStatus::Code::READER_IO_ERROR);
+    ASSERT_EQ(status.getErrorCode(), 9);
+    try {
+        status.throwIfError();
+        FAIL();
+    } catch (const ReaderIOException& e) {
+        ASSERT_EQ(e.getCode(), 9);
+    }
+}
+
+TEST(ReaderSpiTest, tryCheckCardPresence_whenUnexpectedErrorOccurs_shouldReturnUnexpectedError)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, checkCardPresence()).WillOnce(Throw(std::runtime_error("Driver bug")));
+
+    bool isCardPresent = false;
+    const ReaderStatus status = reader.tryCheckCardPresence(isCardPresent);
+    ASSERT_EQ(status.getCode(), ReaderStatus::Code::UNEXPECTED_ERROR);
+    ASSERT_STREQ(status.getReason(), "Unexpected reader error");
+    ASSERT_EQ(status.getErrorCode(), 0);
+    EXPECT_THROW(status.throwIfError(), ReaderIOException);
+}
+
+TEST(ReaderSpiTest, transmitApdus_whenNoStopCondition_shouldTransmitAllApdus)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU)).Times(3).WillRepeatedly(Return(RESP_KO));
+
+    const std::vector<std::vector<uint8_t>> responses =
+        reader.transmitApdus({BatchedApdu(APDU), BatchedApdu(APDU), BatchedApdu(APDU)});
+
+    ASSERT_EQ(responses.size(), 3u);
+}
+
+TEST(ReaderSpiTest, transmitApdus_whenStatusWordIsUnsuccessful_shouldStop)
+{
+    ReaderSpiMock reader;
+    EXPECT_CALL(reader, transmitApdu(APDU))
+        .WillOnce(Return(RESP_OK))
+        .WillOnce(Return(RESP_KO));
+
+    const std::vector<std::vector<uint8_t>> responses =
+        reader.transmitApdus({BatchedApdu(APDU, {0x9000}, true),
+                              BatchedApdu(APDU, {0x9000}, true),
+                              BatchedApdu(APDU, {0x9000}, true)});
+
+    ASSERT_EQ(responses.size(), 2u);
+    ASSERT_EQ(responses[1], RESP_KO);
+}
+
+TEST(ReaderSpiTest, transmitApduStreaming_whenDataExceedsOneApdu_shouldChainCommands)
+{
+    ReaderSpiMock reader;
+    std::vector<std::vector<uint8_t>> commands;
+    EXPECT_CALL(reader, transmitApdu(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(Invoke([&commands](const std::vector<uint8_t>& apdu) {
+                                  commands.push_back(apdu);
+                              }),
+                              Return(RESP_OK)));
+
+    std::size_t remaining = 300;
+    std::vector<uint8_t> response;
+    const int statusWord = reader.transmitApduStreaming(
+        0x80, 0xD6, 0x00, 0x00,
+        [&remaining](uint8_t* buffer, std::size_t capacity) {
+            const std::size_t length = std::min(remaining, capacity);
+            std::fill(buffer, buffer + length, 0xAB);
+            remaining -= length;
+            return length;
+        },
+        [&response](const uint8_t* data, std::size_t length) {
+            response.insert(response.end(), data, data + length);
+        });
+
+    ASSERT_EQ(statusWord, 0x9000);
+    ASSERT_THAT(response, ElementsAre(0x12, 0x34));
+    ASSERT_EQ(commands[0].size(), 5u + 255u);
+    ASSERT_EQ(commands[0][0], 0x90);
+    ASSERT_EQ(commands[0][4], 255);
+    ASSERT_EQ(commands[1].size(), 5u + 45u + 1u);
+    ASSERT_EQ(commands[1][0], 0x80);
+    ASSERT_EQ(commands[1][4], 45);
+}
+
+TEST(ReaderSpiTest, transmitApduStreaming_whenNoResponseDataIsExpected_shouldNotSendLe)
+{
+    ReaderSpiMock reader;
+    std::vector<uint8_t> command;
+    EXPECT_CALL(reader, transmitApdu(_))
+        .WillOnce(DoAll(SaveArg<0>(&command), Return(std::vector<uint8_t>({0x90, 0x00}))));
+
+    bool isProvided = false;
+    const int statusWord = reader.transmitApduStreaming(
+        0x00, 0xD6, 0x00, 0x00,
+        [&isProvided](uint8_t* buffer, std::size_t capacity) {
+            if (isProvided || capacity < 3) {
+                return std::size_t(0);
+            }
+            std::fill(buffer, buffer + 3, 0xAB);
+            isProvided = true;
+            return std::size_t(3);
+        },
+        ReaderSpi::ApduChunkSink());
+
+    ASSERT_EQ(statusWord, 0x9000);
+    ASSERT_THAT(command, ElementsAre(0x00, 0xD6, 0x00, 0x00, 0x03, 0xAB, 0xAB, 0xAB));
+}
@@ -0,0 +1,177 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "ReadinessMultiplexer.h"
+#include "VirtualReaderSpi.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+
+TEST(ReadinessMultiplexerTest, waitOnce_whenNothingIsReady_shouldTimeOut)
+{
+    ReadinessMultiplexer multiplexer;
+    ReadinessEvent event;
+    multiplexer.add(event.getHandle(), [] { FAIL(); });
+
+    /* Consumes the wake-up caused by the registration */
+    multiplexer.waitOnce(std::chrono::milliseconds(0));
+
+    ASSERT_EQ(multiplexer.waitOnce(std::chrono::milliseconds(10)), 0u);
+}
+
+TEST(ReadinessMultiplexerTest, waitOnce_shouldInvokeCallbacksOfReadyHandlesOnly)
+{
+    ReadinessMultiplexer multiplexer;
+    ReadinessEvent event1;
+    ReadinessEvent event2;
+    int calls1 = 0;
+    int calls2 = 0;
+    multiplexer.add(event1.getHandle(), [&event1, &calls1] {
+        event1.clear();
+        calls1++;
+    });
+    multiplexer.add(event2.getHandle(), [&event2, &calls2] {
+        event2.clear();
+        calls2++;
+    });
+
+    std::thread signaler([&event2] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        event2.signal();
+    });
+    while (calls2 == 0) {
+        multiplexer.waitOnce(std::chrono::milliseconds(1000));
+    }
+    signaler.join();
+
+    ASSERT_EQ(calls1, 0);
+    ASSERT_EQ(calls2, 1);
+    ASSERT_EQ(multiplexer.waitOnce(std::chrono::milliseconds(0)), 0u);
+}
+
+TEST(ReadinessMultiplexerTest, add_whenAlreadyRegistered_shouldThrowIAE)
+{
+    ReadinessMultiplexer multiplexer;
+    ReadinessEvent event;
+    multiplexer.add(event.getHandle(), [] {});
+
+    EXPECT_THROW(multiplexer.add(event.getHandle(), [] {}), IllegalArgumentException);
+    ASSERT_TRUE(multiplexer.remove(event.getHandle()));
+    ASSERT_FALSE(multiplexer.remove(event.getHandle()));
+}
+
+TEST(ReadinessMultiplexerTest, remove_fromCallback_shouldSkipPendingCallback)
+{
+    ReadinessMultiplexer multiplexer;
+    ReadinessEvent event1;
+    ReadinessEvent event2;
+    int calls = 0;
+    multiplexer.add(event1.getHandle(), [&multiplexer, &event1, &event2, &calls] {
+        event1.clear();
+        multiplexer.remove(event2.getHandle());
+        calls++;
+    });
+    multiplexer.add(event2.getHandle(), [&multiplexer, &event1, &event2, &calls] {
+        event2.clear();
+        multiplexer.remove(event1.getHandle());
+        calls++;
+    });
+
+    event1.signal();
+    event2.signal();
+
+    ASSERT_EQ(multiplexer.waitOnce(std::chrono::milliseconds(1000)), 1u);
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(ReadinessMultiplexerTest, remove_whenCallbackIsRunning_shouldWaitForIt)
+{
+    ReadinessMultiplexer multiplexer;
+    ReadinessEvent event;
+    std::atomic<bool> isRunning(false);
+    std::atomic<bool> isReleased(false);
+    std::atomic<bool> isCompleted(false);
+    multiplexer.add(event.getHandle(), [&event, &isRunning, &isReleased, &isCompleted] {
+        event.clear();
+        isRunning = true;
+        while (!isReleased) {
+            std::this_thread::yield();
+        }
+        isCompleted = true;
+    });
+
+    event.signal();
+    std::thread dispatcher([&multiplexer, &isRunning] {
+        while (!isRunning) {
+            multiplexer.waitOnce(std::chrono::milliseconds(100));
+        }
+    });
+    while (!isRunning) {
+        std::this_thread::yield();
+    }
+
+    bool isCompletedOnReturn = false;
+    std::thread remover([&multiplexer, &event, &isCompleted, &isCompletedOnReturn] {
+        ASSERT_TRUE(multiplexer.remove(event.getHandle()));
+        isCompletedOnReturn = isCompleted;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    isReleased = true;
+    remover.join();
+    dispatcher.join();
+
+    ASSERT_TRUE(isCompletedOnReturn);
+}
+
+TEST(ReadinessMultiplexerTest, run_shouldObserveManyReadersFromOneThread)
+{
+    ReadinessMultiplexer multiplexer;
+    std::vector<std::shared_ptr<VirtualReaderSpi>> readers;
+    std::atomic<int> insertionCount(0);
+
+    for (int i = 0; i < 64; i++) {
+        auto reader = std::make_shared<VirtualReaderSpi>("READER-" + std::to_string(i), true);
+        multiplexer.add(reader->getReadinessHandle(), [reader, &insertionCount] {
+            reader->acknowledgeReadiness();
+            if (reader->checkCardPresence()) {
+                insertionCount++;
+            }
+        });
+        readers.push_back(reader);
+    }
+
+    std::thread observer([&multiplexer] { multiplexer.run(); });
+
+    for (const auto& reader : readers) {
+        reader->insertCard({0x3B, 0x00}, [](const std::vector<uint8_t>&) {
+            return std::vector<uint8_t>({0x90, 0x00});
+        });
+    }
+    for (int i = 0; i < 100 && insertionCount < 64; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    multiplexer.stop();
+    observer.join();
+
+    ASSERT_EQ(insertionCount, 64);
+}
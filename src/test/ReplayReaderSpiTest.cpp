@@ -0,0 +1,196 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "CardIOException.h"
+#include "ReaderIOException.h"
+#include "ReplayPluginSpi.h"
+#include "TracingReaderSpi.h"
+
+/* Mock */
+#include "mock/ReaderSpiMock.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+
+static const std::string READER_NAME = "READER_1";
+static const std::vector<uint8_t> APDU1 = {0x00, 0xA4, 0x04, 0x00, 0x00};
+static const std::vector<uint8_t> APDU2 = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> RESP1 = {0x6F, 0x00, 0x90, 0x00};
+static const std::vector<uint8_t> RESP2 = {0x12, 0x34, 0x90, 0x00};
+static const std::vector<uint8_t> RESP3 = {0x6A, 0x83};
+
+static const ApduTraceDecoder recordSession(const std::chrono::milliseconds& apdu2Latency)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, getName()).WillRepeatedly(ReturnRef(READER_NAME));
+    EXPECT_CALL(*reader, openPhysicalChannel()).Times(1);
+    EXPECT_CALL(*reader, getPowerOnData()).WillOnce(Return("3B8F8001"));
+    EXPECT_CALL(*reader, checkCardPresence()).WillOnce(Return(true)).WillOnce(Return(false));
+    EXPECT_CALL(*reader, transmitApdu(APDU1)).WillOnce(Return(RESP1));
+    EXPECT_CALL(*reader, transmitApdu(APDU2))
+        .WillOnce(DoAll(Invoke([apdu2Latency](const std::vector<uint8_t>&) {
+                            std::this_thread::sleep_for(apdu2Latency);
+                        }),
+                        Return(RESP2)))
+        .WillOnce(Return(RESP3))
+        .WillOnce(Throw(CardIOException("Card removed")));
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+
+    tracing.checkCardPresence();
+    tracing.openPhysicalChannel();
+    tracing.transmitApdu(APDU1);
+    tracing.transmitApdu(APDU2);
+    tracing.transmitApdu(APDU2);
+    EXPECT_THROW(tracing.transmitApdu(APDU2), CardIOException);
+    tracing.checkCardPresence();
+
+    return ApduTraceDecoder(traceBuffer->serialize());
+}
+
+TEST(ReplayReaderSpiTest, transmitApdu_shouldReplayRecordedResponsesInOrder)
+{
+    ReplayReaderSpi replay(recordSession(std::chrono::milliseconds(0)), true);
+
+    ASSERT_EQ(replay.getName(), READER_NAME);
+    ASSERT_TRUE(replay.checkCardPresence());
+
+    replay.openPhysicalChannel();
+    ASSERT_TRUE(replay.isPhysicalChannelOpen());
+    ASSERT_EQ(replay.getPowerOnData(), "3B8F8001");
+
+    ASSERT_EQ(replay.transmitApdu(APDU1), RESP1);
+    ASSERT_EQ(replay.transmitApdu(APDU2), RESP2);
+    ASSERT_EQ(replay.transmitApdu(APDU2), RESP3);
+    EXPECT_THROW(replay.transmitApdu(APDU2), CardIOException);
+    ASSERT_FALSE(replay.checkCardPresence());
+
+    /* Wraps around */
+    ASSERT_EQ(replay.transmitApdu(APDU2), RESP2);
+    ASSERT_TRUE(replay.checkCardPresence());
+
+    replay.closePhysicalChannel();
+    ASSERT_FALSE(replay.isPhysicalChannelOpen());
+    ASSERT_EQ(replay.getPowerOnData(), "");
+}
+
+TEST(ReplayReaderSpiTest, transmitApdu_whenNotRecorded_shouldThrowCIOE)
+{
+    ReplayReaderSpi replay(recordSession(std::chrono::milliseconds(0)), true);
+
+    EXPECT_THROW(replay.transmitApdu(std::vector<uint8_t>({0x00, 0x84, 0x00, 0x00, 0x08})),
+                 CardIOException);
+}
+
+TEST(ReplayReaderSpiTest, transmitApdu_whenReaderFailureRecorded_shouldThrowRIOE)
+{
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, transmitApdu(APDU1))
+        .WillOnce(Throw(ReaderIOException("Reader unplugged")));
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+    EXPECT_THROW(tracing.transmitApdu(APDU1), ReaderIOException);
+
+    ReplayReaderSpi replay(ApduTraceDecoder(traceBuffer->serialize()), true);
+
+    EXPECT_THROW(replay.transmitApdu(APDU1), ReaderIOException);
+}
+
+TEST(ReplayReaderSpiTest, transmitApdu_whenTimingEmulated_shouldLastAsRecorded)
+{
+    const ApduTraceDecoder trace = recordSession(std::chrono::milliseconds(20));
+    ReplayReaderSpi replay(trace, true, true);
+
+    replay.transmitApdu(APDU1);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    replay.transmitApdu(APDU2);
+
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+/**
+ * Source delivering the provided data in chunks of the provided size at most.
+ */
+static ReaderSpi::ApduChunkSource createSource(const std::vector<uint8_t>& data,
+                                               const std::size_t chunkLength)
+{
+    auto offset = std::make_shared<std::size_t>(0);
+    return [data, chunkLength, offset](uint8_t* buffer, std::size_t capacity) {
+        const std::size_t length = std::min(std::min(chunkLength, capacity), data.size() - *offset);
+        std::copy(data.begin() + *offset, data.begin() + *offset + length, buffer);
+        *offset += length;
+        return length;
+    };
+}
+
+TEST(ReplayReaderSpiTest, transmitApduStreaming_shouldReplayRecordedStream)
+{
+    const std::vector<uint8_t> commandData(300, 0x5A);
+    auto reader = std::make_shared<ReaderSpiMock>();
+    EXPECT_CALL(*reader, getName()).WillRepeatedly(ReturnRef(READER_NAME));
+    EXPECT_CALL(*reader, transmitApdu(_))
+        .WillOnce(Return(std::vector<uint8_t>({0x90, 0x00})))
+        .WillOnce(Return(std::vector<uint8_t>({0xAB, 0xCD, 0x90, 0x00})));
+
+    auto traceBuffer = std::make_shared<ApduTraceBuffer>(READER_NAME);
+    TracingReaderSpi tracing(reader, traceBuffer);
+    tracing.transmitApduStreaming(
+        0x00, 0xD6, 0x00, 0x00, createSource(commandData, 255), [](const uint8_t*, std::size_t) {});
+
+    ReplayReaderSpi replay(ApduTraceDecoder(traceBuffer->serialize()), true);
+
+    /* The chunk sizes of the replayed stream differ from the recorded ones */
+    std::vector<uint8_t> response;
+    ASSERT_EQ(replay.transmitApduStreaming(
+                  0x00,
+                  0xD6,
+                  0x00,
+                  0x00,
+                  createSource(commandData, 100),
+                  [&response](const uint8_t* data, std::size_t length) {
+                      response.insert(response.end(), data, data + length);
+                  }),
+              0x9000);
+    ASSERT_EQ(response, std::vector<uint8_t>({0xAB, 0xCD}));
+
+    const std::vector<uint8_t> otherData(300, 0xA5);
+    EXPECT_THROW(replay.transmitApduStreaming(
+                     0x00, 0xD6, 0x00, 0x00, createSource(otherData, 100), nullptr),
+                 CardIOException);
+}
+
+TEST(ReplayReaderSpiTest, replayPluginSpi_shouldExposeOneReaderPerTrace)
+{
+    const ApduTraceDecoder trace = recordSession(std::chrono::milliseconds(0));
+    ReplayPluginSpi plugin("REPLAY", {trace, trace}, false);
+
+    const std::vector<std::shared_ptr<ReaderSpi>> readers = plugin.searchAvailableReaders();
+
+    ASSERT_EQ(plugin.getName(), "REPLAY");
+    ASSERT_EQ(readers.size(), 2u);
+    ASSERT_NE(readers[0], readers[1]);
+    ASSERT_FALSE(readers[0]->isContactless());
+    ASSERT_EQ(readers[1]->transmitApdu(APDU1), RESP1);
+}
@@ -0,0 +1,260 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin */
+#include "CardIOException.h"
+#include "PluginIOException.h"
+#include "ReaderIOException.h"
+#include "TaskCanceledException.h"
+#include "VirtualObservablePluginSpi.h"
+#include "VirtualPoolPluginSpi.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::cpp;
+using namespace keyple::core::plugin::spi::reader::observable;
+
+static const std::vector<uint8_t> POWER_ON_DATA = {0x3B, 0x8F, 0x80, 0x01};
+static const std::vector<uint8_t> APDU = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> RESP = {0x12, 0x34, 0x90, 0x00};
+
+static const std::vector<uint8_t> respond(const std::vector<uint8_t>& apduIn)
+{
+    return apduIn == APDU ? RESP : std::vector<uint8_t>({0x6D, 0x00});
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_shouldSimulateCardSession)
+{
+    VirtualReaderSpi reader("READER", true);
+
+    ASSERT_FALSE(reader.checkCardPresence());
+    EXPECT_THROW(reader.openPhysicalChannel(), CardIOException);
+
+    reader.insertCard(POWER_ON_DATA, respond);
+    ASSERT_TRUE(reader.checkCardPresence());
+
+    reader.openPhysicalChannel();
+    ASSERT_EQ(reader.getPowerOnData(), "3B8F8001");
+    ASSERT_EQ(reader.getPowerOnDataView().getSize(), 4u);
+    ASSERT_EQ(reader.transmitApdu(APDU), RESP);
+    ASSERT_EQ(reader.transmitApdu({0x00, 0x84, 0x00, 0x00, 0x08}),
+              std::vector<uint8_t>({0x6D, 0x00}));
+    ASSERT_EQ(reader.getTransmittedApduCount(), 2u);
+
+    reader.removeCard();
+    ASSERT_FALSE(reader.isPhysicalChannelOpen());
+    EXPECT_THROW(reader.transmitApdu(APDU), CardIOException);
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_whenErrorRateIsOne_shouldAlwaysFail)
+{
+    VirtualReaderSpi reader("READER", true);
+    reader.insertCard(POWER_ON_DATA, respond);
+    reader.openPhysicalChannel();
+
+    reader.setErrorRate(1);
+
+    EXPECT_THROW(reader.transmitApdu(APDU), CardIOException);
+    EXPECT_THROW(reader.checkCardPresence(), ReaderIOException);
+
+    reader.setErrorRate(0);
+    ASSERT_EQ(reader.transmitApdu(APDU), RESP);
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_tryTransmitApdu_whenCardIsRemoved_shouldNotThrow)
+{
+    VirtualReaderSpi reader("READER", true);
+    reader.insertCard(POWER_ON_DATA, respond);
+    ASSERT_TRUE(reader.tryOpenPhysicalChannel().isOk());
+
+    uint8_t apduOut[258];
+    std::size_t length = 0;
+    ASSERT_TRUE(reader.tryTransmitApdu(APDU.data(), APDU.size(), apduOut, 258, length).isOk());
+    ASSERT_EQ(std::vector<uint8_t>(apduOut, apduOut + length), RESP);
+
+    reader.removeCard();
+
+    ASSERT_EQ(reader.tryTransmitApdu(APDU.data(), APDU.size(), apduOut, 258, length).getCode(),
+              ReaderStatus::Code::CARD_IO_ERROR);
+    ASSERT_EQ(reader.tryOpenPhysicalChannel().getCode(), ReaderStatus::Code::CARD_IO_ERROR);
+    ASSERT_EQ(reader.getTransmittedApduCount(), 1u);
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_shouldApplyLatency)
+{
+    VirtualReaderSpi reader("READER", true);
+    reader.insertCard(POWER_ON_DATA, respond);
+    reader.openPhysicalChannel();
+    reader.setLatency(std::chrono::milliseconds(10));
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    reader.transmitApdu(APDU);
+
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_waitForCardInsertion_shouldReturnOnInsertion)
+{
+    VirtualReaderSpi reader("READER", true);
+
+    std::thread inserter([&reader] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        reader.insertCard(POWER_ON_DATA, respond);
+    });
+    reader.waitForCardInsertion();
+    inserter.join();
+
+    ASSERT_TRUE(reader.checkCardPresence());
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_stopWaitForCardRemoval_shouldThrowTCE)
+{
+    VirtualReaderSpi reader("READER", true);
+    reader.insertCard(POWER_ON_DATA, respond);
+
+    std::thread stopper([&reader] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        reader.stopWaitForCardRemoval();
+    });
+    EXPECT_THROW(reader.waitForCardRemoval(), TaskCanceledException);
+    stopper.join();
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_waitForCardInsertionFor_whenNoCard_shouldTimeOut)
+{
+    VirtualReaderSpi reader("READER", true);
+
+    ASSERT_EQ(reader.waitForCardInsertionFor(std::chrono::milliseconds(10)),
+              WaitStatus::TIMED_OUT);
+
+    reader.insertCard(POWER_ON_DATA, respond);
+    ASSERT_EQ(reader.waitForCardInsertionFor(std::chrono::milliseconds(10)),
+              WaitStatus::COMPLETED);
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_stopWaitForCardRemoval_shouldCancelWaitUntil)
+{
+    VirtualReaderSpi reader("READER", true);
+    reader.insertCard(POWER_ON_DATA, respond);
+
+    std::chrono::steady_clock::time_point stopTime;
+    std::thread stopper([&reader, &stopTime] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        stopTime = std::chrono::steady_clock::now();
+        reader.stopWaitForCardRemoval();
+    });
+    ASSERT_EQ(reader.waitForCardRemovalFor(std::chrono::seconds(10)), WaitStatus::CANCELED);
+    const std::chrono::steady_clock::time_point returnTime = std::chrono::steady_clock::now();
+    stopper.join();
+
+    ASSERT_LE(returnTime - stopTime, std::chrono::milliseconds(MAX_STOP_LATENCY_MILLIS));
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_stopWaitForCardInsertion_beforeWait_shouldCancelIt)
+{
+    VirtualReaderSpi reader("READER", true);
+
+    reader.stopWaitForCardInsertion();
+    ASSERT_EQ(reader.waitForCardInsertionFor(std::chrono::seconds(10)), WaitStatus::CANCELED);
+    ASSERT_EQ(reader.waitForCardInsertionFor(std::chrono::milliseconds(0)),
+              WaitStatus::TIMED_OUT);
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_stopWaitForCardRemoval_shouldNotCancelInsertionWait)
+{
+    VirtualReaderSpi reader("READER", true);
+
+    reader.stopWaitForCardRemoval();
+    ASSERT_EQ(reader.waitForCardInsertionFor(std::chrono::milliseconds(0)),
+              WaitStatus::TIMED_OUT);
+
+    reader.insertCard(POWER_ON_DATA, respond);
+    ASSERT_EQ(reader.waitForCardRemovalFor(std::chrono::seconds(10)), WaitStatus::CANCELED);
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_waitForCardInsertionFor_whenTimeoutIsMax_shouldWait)
+{
+    VirtualReaderSpi reader("READER", true);
+    reader.insertCard(POWER_ON_DATA, respond);
+
+    ASSERT_TRUE(reader.isCardInsertionDeadlineSupported());
+    ASSERT_EQ(reader.waitForCardInsertionFor(std::chrono::milliseconds::max()),
+              WaitStatus::COMPLETED);
+    ASSERT_EQ(getDeadline(std::chrono::milliseconds::max()),
+              std::chrono::steady_clock::time_point::max());
+}
+
+TEST(VirtualPluginSpiTest, virtualReaderSpi_getReadinessHandle_shouldCreateEventOnce)
+{
+    VirtualReaderSpi reader("READER", true);
+
+    /* Without event yet, the readiness changes are not recorded */
+    reader.insertCard(POWER_ON_DATA, respond);
+    reader.acknowledgeReadiness();
+
+    const MultiplexedObservationSpi::ReadinessHandle handle = reader.getReadinessHandle();
+    ASSERT_EQ(reader.getReadinessHandle(), handle);
+}
+
+TEST(VirtualPluginSpiTest, virtualObservablePluginSpi_shouldTrackReaderChanges)
+{
+    VirtualObservablePluginSpi plugin("VIRTUAL", 3, true);
+
+    ASSERT_EQ(plugin.searchAvailableReaderNames(),
+              std::vector<std::string>({"VIRTUAL-0", "VIRTUAL-1", "VIRTUAL-2"}));
+    ASSERT_EQ(plugin.searchAvailableReaders().size(), 3u);
+
+    const uint64_t epoch = plugin.getReaderNamesEpoch();
+    plugin.connectReader("EXTRA", false);
+    ASSERT_TRUE(plugin.disconnectReader("VIRTUAL-1"));
+    ASSERT_FALSE(plugin.disconnectReader("UNKNOWN"));
+
+    std::vector<std::string> connected;
+    std::vector<std::string> disconnected;
+    ASSERT_TRUE(plugin.searchReaderNamesChanges(epoch, connected, disconnected));
+    ASSERT_EQ(connected, std::vector<std::string>({"EXTRA"}));
+    ASSERT_EQ(disconnected, std::vector<std::string>({"VIRTUAL-1"}));
+
+    ASSERT_EQ(plugin.searchReader("VIRTUAL-1"), nullptr);
+    ASSERT_NE(plugin.searchReader("EXTRA"), nullptr);
+}
+
+TEST(VirtualPluginSpiTest, virtualPoolPluginSpi_shouldAllocateAndReleaseReaders)
+{
+    VirtualPoolPluginSpi plugin("POOL", {{"GROUP_A", 2}, {"GROUP_B", 1}}, true);
+
+    ASSERT_EQ(plugin.getReaderGroupReferences(),
+              std::vector<std::string>({"GROUP_A", "GROUP_B"}));
+    ASSERT_EQ(plugin.getReaders("GROUP_A").size(), 2u);
+
+    std::shared_ptr<ReaderSpi> reader1 = plugin.allocateReader("GROUP_A");
+    std::shared_ptr<ReaderSpi> reader2 = plugin.allocateReader("GROUP_A");
+    ASSERT_NE(reader1, reader2);
+    EXPECT_THROW(plugin.allocateReader("GROUP_A"), PluginIOException);
+    EXPECT_THROW(plugin.allocateReader("UNKNOWN"), PluginIOException);
+
+    ASSERT_EQ(plugin.allocateReader("")->getName(), "GROUP_B-0");
+
+    plugin.releaseReader(reader1);
+    plugin.releaseReader(reader1);
+    ASSERT_EQ(plugin.allocateReader("GROUP_A"), reader1);
+    EXPECT_THROW(plugin.allocateReader("GROUP_A"), PluginIOException);
+
+    EXPECT_THROW(plugin.releaseReader(std::make_shared<VirtualReaderSpi>("OTHER", true)),
+                 PluginIOException);
+}
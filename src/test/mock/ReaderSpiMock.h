@@ -0,0 +1,38 @@
+/**************************************************************************************************
+ * Copyright (c) 2021 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include "gmock/gmock.h"
+
+/* Keyple Plugin */
+#include "ReaderSpi.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin::spi::reader;
+
+class ReaderSpiMock : public ReaderSpi {
+public:
+    MOCK_METHOD((const std::string&), getName, (), (const, override));
+    MOCK_METHOD(void, openPhysicalChannel, (), (override));
+    MOCK_METHOD(void, closePhysicalChannel, (), (override));
+    MOCK_METHOD(bool, isPhysicalChannelOpen, (), (const, override));
+    MOCK_METHOD(bool, checkCardPresence, (), (override));
+    MOCK_METHOD(const std::string, getPowerOnData, (), (const, override));
+    MOCK_METHOD(const std::vector<uint8_t>,
+                transmitApdu,
+                (const std::vector<uint8_t>&),
+                (override));
+    MOCK_METHOD(bool, isContactless, (), (override));
+    MOCK_METHOD(void, onUnregister, (), (override));
+};